@@ -0,0 +1,450 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Run with --benchmark_out=<file> --benchmark_out_format=json to get
+// machine-readable results (the RunECSEngineBench target does this).
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "../src/ECS/ECS.h"
+#include "../src/PrimitiveTypes.h"
+
+namespace
+{
+	struct Position { f32 x = 0.0f, y = 0.0f, z = 0.0f; };
+	struct Velocity { f32 x = 1.0f, y = 1.0f, z = 1.0f; };
+	struct Health { s32 value = 100; };
+
+	// Fixed seed so every build shuffles the same way and results stay comparable
+	constexpr u32 BENCH_SEED = 1337;
+
+	std::vector<ECS::Entity> CreatePopulatedEntities(ECS::Registry& registry, s64 count)
+	{
+		std::vector<ECS::Entity> entities;
+		entities.reserve((size_t)count);
+
+		for (s64 i = 0; i < count; ++i)
+		{
+			auto e = registry.CreateEntity();
+			registry.AddComponent<Position>(e);
+			entities.push_back(e);
+		}
+		registry.Update();
+
+		return entities;
+	}
+}
+
+// Entity lifecycle
+static void BM_CreateEntity(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	for (auto _ : state)
+	{
+		ECS::Registry registry;
+		for (s64 i = 0; i < count; ++i)
+			benchmark::DoNotOptimize(registry.CreateEntity());
+		registry.Update();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_CreateEntity)->Arg(1000)->Arg(100000);
+
+static void BM_CreateEntities_Batched(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+	std::vector<ECS::Entity> entities((size_t)count);
+	std::vector<Position> positions((size_t)count);
+
+	for (auto _ : state)
+	{
+		ECS::Registry registry;
+		registry.CreateEntities((size_t)count, entities);
+		registry.AddComponents<Position>(entities, positions);
+		registry.Update();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_CreateEntities_Batched)->Arg(1000)->Arg(100000);
+
+static void BM_KillEntity(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		ECS::Registry registry;
+		auto entities = CreatePopulatedEntities(registry, count);
+		state.ResumeTiming();
+
+		for (auto& e : entities)
+			registry.KillEntity(e);
+		registry.Update();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_KillEntity)->Arg(1000)->Arg(100000);
+
+static void BM_EntityChurn(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	// Steady state: every frame kills the entities of the previous one and creates as many
+	ECS::Registry registry;
+	registry.Reserve((size_t)count);
+	std::vector<ECS::Entity> entities;
+	entities.reserve((size_t)count);
+	for (s64 i = 0; i < count; ++i)
+		entities.push_back(registry.CreateEntity());
+	registry.Update();
+
+	for (auto _ : state)
+	{
+		for (auto& e : entities)
+			registry.KillEntity(e);
+		registry.Update();
+
+		for (auto& e : entities)
+			e = registry.CreateEntity();
+		registry.Update();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_EntityChurn)->Arg(1000)->Arg(100000);
+
+// Component management
+static void BM_AddRemoveComponent(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+
+	for (auto _ : state)
+	{
+		for (auto& e : entities)
+			registry.AddComponent<Velocity>(e);
+		for (auto& e : entities)
+			registry.RemoveComponent<Velocity>(e);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_AddRemoveComponent)->Arg(1000)->Arg(100000);
+
+static void BM_GetComponent_Sequential(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+
+	for (auto _ : state)
+	{
+		f32 sum = 0.0f;
+		for (auto& e : entities)
+			sum += registry.GetComponent<Position>(e).x;
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GetComponent_Sequential)->Arg(1000)->Arg(100000);
+
+static void BM_GetComponent_Random(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+
+	std::mt19937 g(BENCH_SEED);
+	std::shuffle(entities.begin(), entities.end(), g);
+
+	for (auto _ : state)
+	{
+		f32 sum = 0.0f;
+		for (auto& e : entities)
+			sum += registry.GetComponent<Position>(e).x;
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GetComponent_Random)->Arg(1000)->Arg(100000);
+
+// Views
+static void BM_View_One(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	CreatePopulatedEntities(registry, count);
+
+	for (auto _ : state)
+	{
+		registry.View<Position>([](ECS::EntityID, Position& p) {
+			p.x += 1.0f;
+			});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_View_One)->Arg(1000)->Arg(100000);
+
+// range(0) = entity count, range(1) = percentage of entities owning the extra components
+static void BM_View_Three(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+	const s64 density = state.range(1);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+
+	std::mt19937 g(BENCH_SEED);
+	std::uniform_int_distribution<s64> percent(0, 99);
+	for (auto& e : entities)
+	{
+		if (percent(g) < density)
+		{
+			registry.AddComponent<Velocity>(e);
+			registry.AddComponent<Health>(e);
+		}
+	}
+
+	for (auto _ : state)
+	{
+		registry.View<Position, Velocity, Health>([](ECS::EntityID, Position& p, Velocity& v, Health& h) {
+			p.x += v.x;
+			h.value -= 1;
+			});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_View_Three)
+	->ArgsProduct({ { 1000, 100000 }, { 1, 10, 50, 100 } });
+
+static void BM_View_Three_Archetype(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+	const s64 density = state.range(1);
+
+	ECS::Registry registry(ECS::StorageMode::Archetype);
+	auto entities = CreatePopulatedEntities(registry, count);
+
+	std::mt19937 g(BENCH_SEED);
+	std::uniform_int_distribution<s64> percent(0, 99);
+	for (auto& e : entities)
+	{
+		if (percent(g) < density)
+		{
+			registry.AddComponent<Velocity>(e);
+			registry.AddComponent<Health>(e);
+		}
+	}
+
+	for (auto _ : state)
+	{
+		registry.View<Position, Velocity, Health>([](ECS::EntityID, Position& p, Velocity& v, Health& h) {
+			p.x += v.x;
+			h.value -= 1;
+			});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_View_Three_Archetype)
+	->ArgsProduct({ { 1000, 100000 }, { 1, 10, 50, 100 } });
+
+static void BM_View_Two_OwningGroup(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+	const s64 density = state.range(1);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+	registry.OwnGroup<Position, Velocity>();
+
+	std::mt19937 g(BENCH_SEED);
+	std::uniform_int_distribution<s64> percent(0, 99);
+	for (auto& e : entities)
+	{
+		if (percent(g) < density)
+			registry.AddComponent<Velocity>(e);
+	}
+
+	for (auto _ : state)
+	{
+		registry.View<Position, Velocity>([](ECS::EntityID, Position& p, Velocity& v) {
+			p.x += v.x;
+			});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_View_Two_OwningGroup)
+	->ArgsProduct({ { 1000, 100000 }, { 10, 100 } });
+
+static void BM_ForEachChunk_Two_OwningGroup(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+	registry.OwnGroup<Position, Velocity>();
+	for (auto& e : entities)
+		registry.AddComponent<Velocity>(e);
+
+	for (auto _ : state)
+	{
+		registry.ForEachChunk<Position, Velocity>([](std::span<const ECS::EntityID>, std::span<Position> p, std::span<Velocity> v) {
+			for (size_t i = 0; i < p.size(); ++i)
+				p[i].x += v[i].x;
+			});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ForEachChunk_Two_OwningGroup)->Arg(1000)->Arg(100000);
+
+// range(0) = entity count, range(1) = worker threads
+static void BM_ParallelView_Two(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	registry.SetThreadPool(std::make_shared<ECS::ThreadPool>((u32)state.range(1)));
+	auto entities = CreatePopulatedEntities(registry, count);
+	for (auto& e : entities)
+		registry.AddComponent<Velocity>(e);
+
+	for (auto _ : state)
+	{
+		registry.ParallelView<Position, Velocity>([](ECS::EntityID, Position& p, Velocity& v) {
+			p.x += v.x;
+			p.y += v.y;
+			p.z += v.z;
+			});
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParallelView_Two)
+	->ArgsProduct({ { 100000, 1000000 }, { 0, 3, 7 } })
+	->UseRealTime();
+
+// Tags and groups
+static void BM_EntityBelongsToGroup(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+	for (size_t i = 0; i < entities.size(); i += 2)
+		registry.GroupEntity(entities[i], "enemies");
+
+	for (auto _ : state)
+	{
+		s64 matches = 0;
+		for (auto& e : entities)
+			matches += registry.EntityBelongsToGroup(e, "enemies");
+		benchmark::DoNotOptimize(matches);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_EntityBelongsToGroup)->Arg(1000)->Arg(100000);
+
+static void BM_EntityHasTag(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, count);
+	registry.TagEntity(entities[count / 2], "player");
+
+	for (auto _ : state)
+	{
+		s64 matches = 0;
+		for (auto& e : entities)
+			matches += registry.EntityHasTag(e, "player");
+		benchmark::DoNotOptimize(matches);
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_EntityHasTag)->Arg(1000)->Arg(100000);
+
+static void BM_GetEntityByTag(benchmark::State& state)
+{
+	ECS::Registry registry;
+	auto entities = CreatePopulatedEntities(registry, 1000);
+	registry.TagEntity(entities[500], "player");
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(registry.GetEntityByTag("player"));
+}
+BENCHMARK(BM_GetEntityByTag);
+
+// Forks
+static void BM_RestoreFrom_Rollback(benchmark::State& state)
+{
+	const s64 count = state.range(0);
+
+	ECS::Registry world;
+	auto entities = CreatePopulatedEntities(world, count);
+	for (auto& e : entities)
+		world.AddComponent<Velocity>(e);
+	world.Update();
+
+	// One saved frame copied back every iteration, only the positions move in between
+	auto saved = world.Clone();
+	for (auto _ : state)
+	{
+		world.View<Position>([](ECS::EntityID, Position& p) { p.x += 1.0f; });
+		world.RestoreFrom(*saved);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RestoreFrom_Rollback)->Arg(20000)->Arg(100000);
+
+BENCHMARK_MAIN();
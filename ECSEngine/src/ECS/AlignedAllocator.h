@@ -0,0 +1,68 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <algorithm>
+#include <memory_resource>
+
+namespace ECS
+{
+	// Standard allocator returning memory aligned on at least Alignment bytes,
+	// taken from a memory resource (the default resource if none is given)
+	template<typename T, size_t Alignment>
+	class AlignedAllocator
+	{
+	public:
+		using value_type = T;
+
+		static constexpr size_t alignment = std::max(Alignment, alignof(T));
+
+		template<typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+		AlignedAllocator() noexcept : m_resource(std::pmr::get_default_resource()) {}
+		explicit AlignedAllocator(std::pmr::memory_resource* resource) noexcept : m_resource(resource) {}
+		template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>& other) noexcept : m_resource(other.GetResource()) {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(m_resource->allocate(count * sizeof(T), alignment));
+		}
+
+		void deallocate(T* pointer, size_t count) noexcept
+		{
+			m_resource->deallocate(pointer, count * sizeof(T), alignment);
+		}
+
+		std::pmr::memory_resource* GetResource() const noexcept { return m_resource; }
+
+		template<typename U> bool operator==(const AlignedAllocator<U, Alignment>& other) const noexcept { return *m_resource == *other.GetResource(); }
+
+	private:
+		std::pmr::memory_resource* m_resource;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Archetype.h"
+
+namespace ECS
+{
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	Archetype::Archetype(const Signature& signature, std::vector<const ComponentInfo*> components, std::pmr::memory_resource* resource)
+		: m_signature(signature), m_components(std::move(components)), m_columnByComponent(MAX_COMPONENTS, -1), m_resource(resource)
+	{
+		size_t rowBytes = sizeof(EntityID);
+		for (size_t column = 0; column < m_components.size(); ++column)
+		{
+			assert(m_components[column]->alignment <= CACHE_LINE_SIZE && "Over-aligned components are not supported");
+			m_columnByComponent[m_components[column]->id] = (int)column;
+			rowBytes += m_components[column]->size;
+		}
+
+		// Rows per chunk once every column start is padded to a cache line.
+		// A row larger than a chunk gets a chunk of its own.
+		const size_t padding = (m_components.size() + 1) * CACHE_LINE_SIZE;
+		m_chunkCapacity = (u32)std::max<size_t>(1, m_chunkBytes > padding ? (m_chunkBytes - padding) / rowBytes : 1);
+
+		size_t offset = AlignUp(sizeof(EntityID) * m_chunkCapacity, CACHE_LINE_SIZE);
+		for (const ComponentInfo* component : m_components)
+		{
+			m_columnOffsets.push_back(offset);
+			offset = AlignUp(offset + (size_t)component->size * m_chunkCapacity, CACHE_LINE_SIZE);
+		}
+		m_chunkBytes = std::max(m_chunkBytes, offset);
+	}
+
+	Archetype::~Archetype()
+	{
+		Clear();
+	}
+
+	u32 Archetype::AllocateRow(EntityID entityId)
+	{
+		const u32 row = m_entityCount;
+		if (row / m_chunkCapacity >= m_chunks.size())
+			m_chunks.push_back(static_cast<std::byte*>(m_resource->allocate(m_chunkBytes, CACHE_LINE_SIZE)));
+
+		GetChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity] = entityId;
+		++m_entityCount;
+		return row;
+	}
+
+	EntityID Archetype::RemoveRow(u32 row)
+	{
+		const u32 lastRow = m_entityCount - 1;
+		EntityID movedEntity = u64_invalid_id;
+
+		for (size_t column = 0; column < m_components.size(); ++column)
+		{
+			const ComponentInfo* component = m_components[column];
+			void* removed = GetComponent(row, (int)column);
+			component->destroy(removed);
+
+			// Move the last row into the hole
+			if (row != lastRow)
+			{
+				void* last = GetComponent(lastRow, (int)column);
+				component->moveConstruct(removed, last);
+				component->destroy(last);
+			}
+		}
+
+		if (row != lastRow)
+		{
+			movedEntity = GetEntity(lastRow);
+			GetChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity] = movedEntity;
+		}
+
+		--m_entityCount;
+
+		// Release the last chunk once it is empty
+		if (m_entityCount % m_chunkCapacity == 0 && m_entityCount / m_chunkCapacity < m_chunks.size())
+		{
+			m_resource->deallocate(m_chunks.back(), m_chunkBytes, CACHE_LINE_SIZE);
+			m_chunks.pop_back();
+		}
+
+		return movedEntity;
+	}
+
+	void Archetype::Clear()
+	{
+		for (u32 row = 0; row < m_entityCount; ++row)
+		{
+			for (size_t column = 0; column < m_components.size(); ++column)
+				m_components[column]->destroy(GetComponent(row, (int)column));
+		}
+		m_entityCount = 0;
+
+		for (std::byte* chunk : m_chunks)
+			m_resource->deallocate(chunk, m_chunkBytes, CACHE_LINE_SIZE);
+		m_chunks.clear();
+	}
+
+	Archetype* Archetype::FindEdge(const Edges& edges, u32 componentId)
+	{
+		for (const auto& [id, archetype] : edges)
+		{
+			if (id == componentId)
+				return archetype;
+		}
+		return nullptr;
+	}
+}
\ No newline at end of file
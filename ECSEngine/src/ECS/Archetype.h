@@ -0,0 +1,204 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <new>
+
+namespace ECS
+{
+	// Type-erased description of a component type, enough to store it in archetype chunks
+	struct ComponentInfo
+	{
+		u32 id = 0;
+		u32 size = 0;
+		u32 alignment = 0;
+		void (*moveConstruct)(void* destination, void* source) = nullptr; // Move into uninitialized memory
+		void (*destroy)(void* object) = nullptr;
+
+		template<typename T>
+		static ComponentInfo Create(u32 id)
+		{
+			return {
+				id, (u32)sizeof(T), (u32)alignof(T),
+				[](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+				[](void* object) { static_cast<T*>(object)->~T(); }
+			};
+		}
+	};
+
+	// Storage of all the entities sharing the same Signature.
+	// Entities live in fixed-size chunks (ARCHETYPE_CHUNK_SIZE bytes) with one column per component
+	// (structure of arrays), every column aligned on CACHE_LINE_SIZE. Rows are kept dense:
+	// removing an entity moves the last row into the hole, so row r lives in chunk r / capacity.
+	class Archetype
+	{
+	public:
+		/**
+		 * @brief Construct a new Archetype object.
+		 *
+		 * @param signature The component signature shared by the entities.
+		 * @param components One info per component of the signature, by increasing id.
+		 * @param resource Memory resource the chunks are allocated from.
+		 */
+		Archetype(const Signature& signature, std::vector<const ComponentInfo*> components,
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/**
+		 * @brief Destroy the Archetype object, destroying every stored component.
+		 */
+		~Archetype();
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+
+		const Signature& GetSignature() const { return m_signature; }
+		const std::vector<const ComponentInfo*>& GetComponents() const { return m_components; }
+
+		/**
+		 * @brief Get the number of entities stored in the archetype.
+		 *
+		 * @return u32 Number of entities.
+		 */
+		u32 GetEntityCount() const { return m_entityCount; }
+
+		/**
+		 * @brief Get the number of rows a chunk can hold.
+		 *
+		 * @return u32 Rows per chunk.
+		 */
+		u32 GetChunkCapacity() const { return m_chunkCapacity; }
+
+		/**
+		 * @brief Get the number of allocated chunks.
+		 *
+		 * @return size_t Number of chunks.
+		 */
+		size_t GetChunkCount() const { return m_chunks.size(); }
+
+		/**
+		 * @brief Get the number of rows used in a chunk.
+		 *
+		 * @param chunk Chunk index.
+		 * @return u32 Number of entities in the chunk.
+		 */
+		u32 GetChunkEntityCount(size_t chunk) const
+		{
+			const size_t firstRow = chunk * m_chunkCapacity;
+			return (u32)std::min<size_t>(m_chunkCapacity, m_entityCount - firstRow);
+		}
+
+		/**
+		 * @brief Get the column of a component.
+		 *
+		 * @param componentId Component id.
+		 * @return int Column index, -1 if the component is not part of the archetype.
+		 */
+		int GetColumn(u32 componentId) const { return m_columnByComponent[componentId]; }
+
+		/**
+		 * @brief Get the entity ids stored in a chunk (GetChunkEntityCount() of them).
+		 *
+		 * @param chunk Chunk index.
+		 * @return EntityID* The entity ids of the chunk.
+		 */
+		EntityID* GetChunkEntities(size_t chunk) const { return reinterpret_cast<EntityID*>(m_chunks[chunk]); }
+
+		/**
+		 * @brief Get the start of a column in a chunk, aligned on CACHE_LINE_SIZE.
+		 *
+		 * @param chunk Chunk index.
+		 * @param column Column index (see GetColumn()).
+		 * @return void* The first component of the column.
+		 */
+		void* GetColumnData(size_t chunk, int column) const { return m_chunks[chunk] + m_columnOffsets[column]; }
+
+		/**
+		 * @brief Get a component of the entity stored in a row.
+		 *
+		 * @param row Row index.
+		 * @param column Column index (see GetColumn()).
+		 * @return void* The component.
+		 */
+		void* GetComponent(u32 row, int column) const
+		{
+			return static_cast<std::byte*>(GetColumnData(row / m_chunkCapacity, column)) + (size_t)(row % m_chunkCapacity) * m_components[column]->size;
+		}
+
+		/**
+		 * @brief Get the entity stored in a row.
+		 *
+		 * @param row Row index.
+		 * @return EntityID The entity id.
+		 */
+		EntityID GetEntity(u32 row) const { return GetChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity]; }
+
+		/**
+		 * @brief Append a row for an entity. Its components are left uninitialized,
+		 *	the caller must construct every one of them.
+		 * @param entityId Full entity id.
+		 * @return u32 The new row.
+		 */
+		u32 AllocateRow(EntityID entityId);
+
+		/**
+		 * @brief Destroy the components of a row and fill it with the last row.
+		 *
+		 * @param row Row index.
+		 * @return EntityID The entity moved into row, u64_invalid_id if row was the last one.
+		 */
+		EntityID RemoveRow(u32 row);
+
+		/**
+		 * @brief Destroy every row and release the chunks.
+		 */
+		void Clear();
+
+		// Transition graph: archetype reached by adding/removing one component, cached on first use
+		Archetype* GetAddEdge(u32 componentId) const { return FindEdge(m_addEdges, componentId); }
+		Archetype* GetRemoveEdge(u32 componentId) const { return FindEdge(m_removeEdges, componentId); }
+		void SetAddEdge(u32 componentId, Archetype* archetype) { m_addEdges.emplace_back(componentId, archetype); }
+		void SetRemoveEdge(u32 componentId, Archetype* archetype) { m_removeEdges.emplace_back(componentId, archetype); }
+
+	private:
+		using Edges = std::vector<std::pair<u32, Archetype*>>;
+		static Archetype* FindEdge(const Edges& edges, u32 componentId);
+
+	private:
+		Signature m_signature;
+		std::vector<const ComponentInfo*> m_components; // One per column
+		std::vector<size_t> m_columnOffsets; // Byte offset of each column in a chunk
+		std::vector<int> m_columnByComponent; // [index = componentId] -> column, -1 if absent
+		std::vector<std::byte*> m_chunks;
+		std::pmr::memory_resource* m_resource;
+		size_t m_chunkBytes = ARCHETYPE_CHUNK_SIZE;
+		u32 m_chunkCapacity = 0;
+		u32 m_entityCount = 0;
+		Edges m_addEdges;
+		Edges m_removeEdges;
+	};
+}
\ No newline at end of file
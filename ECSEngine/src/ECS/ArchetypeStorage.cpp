@@ -0,0 +1,169 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ArchetypeStorage.h"
+
+namespace ECS
+{
+	ArchetypeStorage::ArchetypeStorage(std::pmr::memory_resource* resource)
+		: m_componentInfos(MAX_COMPONENTS, resource), m_archetypes(resource), m_archetypeList(resource), m_locations(resource), m_resource(resource)
+	{
+	}
+
+	void ArchetypeStorage::Remove(EntityID entityId, u32 componentId)
+	{
+		EntityLocation& location = GetLocation(entityId);
+		if (!location.archetype || location.archetype->GetColumn(componentId) == -1)
+			return;
+
+		if (Archetype* target = GetRemoveTarget(location.archetype, componentId))
+		{
+			MoveEntity(entityId, target);
+			return;
+		}
+
+		// Last component removed
+		RemoveRow(location.archetype, location.row);
+		location = {};
+	}
+
+	void ArchetypeStorage::RemoveEntity(EntityID entityId)
+	{
+		EntityLocation& location = GetLocation(entityId);
+		if (!location.archetype)
+			return;
+
+		RemoveRow(location.archetype, location.row);
+		location = {};
+	}
+
+	void* ArchetypeStorage::Get(EntityID entityId, u32 componentId) const
+	{
+		const EntityLocation& location = m_locations[GetEntityIndex(entityId)];
+		return location.archetype->GetComponent(location.row, location.archetype->GetColumn(componentId));
+	}
+
+	Archetype* ArchetypeStorage::GetArchetype(EntityID entityId) const
+	{
+		const u32 index = GetEntityIndex(entityId);
+		return index < m_locations.size() ? m_locations[index].archetype : nullptr;
+	}
+
+	ArchetypeStorage::EntityLocation& ArchetypeStorage::GetLocation(EntityID entityId)
+	{
+		const u32 index = GetEntityIndex(entityId);
+		if (index >= m_locations.size())
+			m_locations.resize(index + 1);
+
+		return m_locations[index];
+	}
+
+	Archetype* ArchetypeStorage::GetOrCreateArchetype(const Signature& signature)
+	{
+		auto it = m_archetypes.find(signature);
+		if (it != m_archetypes.end())
+			return it->second.get();
+
+		std::vector<const ComponentInfo*> components;
+		signature.ForEachSetBit([this, &components](u32 componentId) {
+			components.push_back(&m_componentInfos[componentId]);
+			});
+
+		Archetype* archetype = m_archetypes.emplace(signature, MakeResourceUnique<Archetype>(m_resource, signature, std::move(components), m_resource)).first->second.get();
+		m_archetypeList.push_back(archetype);
+		return archetype;
+	}
+
+	Archetype* ArchetypeStorage::GetAddTarget(Archetype* source, u32 componentId)
+	{
+		if (!source)
+		{
+			Signature signature;
+			signature.set(componentId);
+			return GetOrCreateArchetype(signature);
+		}
+
+		if (Archetype* target = source->GetAddEdge(componentId))
+			return target;
+
+		Signature signature = source->GetSignature();
+		signature.set(componentId);
+
+		Archetype* target = GetOrCreateArchetype(signature);
+		source->SetAddEdge(componentId, target);
+		target->SetRemoveEdge(componentId, source);
+		return target;
+	}
+
+	Archetype* ArchetypeStorage::GetRemoveTarget(Archetype* source, u32 componentId)
+	{
+		// Removing the only component leaves the entity without archetype
+		if (source->GetComponents().size() == 1)
+			return nullptr;
+
+		if (Archetype* target = source->GetRemoveEdge(componentId))
+			return target;
+
+		Signature signature = source->GetSignature();
+		signature.set(componentId, false);
+
+		Archetype* target = GetOrCreateArchetype(signature);
+		source->SetRemoveEdge(componentId, target);
+		target->SetAddEdge(componentId, source);
+		return target;
+	}
+
+	u32 ArchetypeStorage::MoveEntity(EntityID entityId, Archetype* target)
+	{
+		EntityLocation& location = m_locations[GetEntityIndex(entityId)];
+		Archetype* source = location.archetype;
+
+		const u32 row = target->AllocateRow(entityId);
+
+		if (source)
+		{
+			// The moved-from components are destroyed with the source row
+			const std::vector<const ComponentInfo*>& components = source->GetComponents();
+			for (size_t column = 0; column < components.size(); ++column)
+			{
+				const int targetColumn = target->GetColumn(components[column]->id);
+				if (targetColumn != -1)
+					components[column]->moveConstruct(target->GetComponent(row, targetColumn), source->GetComponent(location.row, (int)column));
+			}
+
+			RemoveRow(source, location.row);
+		}
+
+		location = { target, row };
+		return row;
+	}
+
+	void ArchetypeStorage::RemoveRow(Archetype* archetype, u32 row)
+	{
+		const EntityID movedEntity = archetype->RemoveRow(row);
+		if (movedEntity != u64_invalid_id)
+			m_locations[GetEntityIndex(movedEntity)].row = row;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+#include "Archetype.h"
+#include "Component.h"
+#include "ResourcePtr.h"
+
+namespace ECS
+{
+	// Component storage of a Registry in StorageMode::Archetype.
+	// Every entity with at least one component lives in the archetype of its Signature.
+	// Adding or removing a component moves the entity to the neighbour archetype, found
+	// through the transition edges cached on each archetype.
+	class ArchetypeStorage
+	{
+	public:
+		/**
+		 * @brief Construct a new ArchetypeStorage object.
+		 *
+		 * @param resource Memory resource the archetypes, their chunks and the entity locations are allocated from.
+		 */
+		explicit ArchetypeStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		ArchetypeStorage(const ArchetypeStorage&) = delete;
+		ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+		/**
+		 * @brief Add a component to an entity, moving it to the archetype that includes T.
+		 *	The component is assigned if the entity already has one.
+		 * @param entityId Full entity id.
+		 * @param componentId Registry component id of T (see Registry::GetComponentId()).
+		 * @param component The component value.
+		 * @return T& The stored component.
+		 */
+		template<typename T> T& Add(EntityID entityId, u32 componentId, T&& component);
+
+		/**
+		 * @brief Remove a component from an entity, moving it to the archetype without it.
+		 *
+		 * @param entityId Full entity id.
+		 * @param componentId Component id.
+		 */
+		void Remove(EntityID entityId, u32 componentId);
+
+		/**
+		 * @brief Remove all the components of an entity.
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void RemoveEntity(EntityID entityId);
+
+		/**
+		 * @brief Get a component of an entity. The entity must have it.
+		 *
+		 * @param entityId Full entity id.
+		 * @param componentId Component id.
+		 * @return void* The component.
+		 */
+		void* Get(EntityID entityId, u32 componentId) const;
+
+		/**
+		 * @brief Get the archetype an entity is stored in.
+		 *
+		 * @param entityId Full entity id.
+		 * @return Archetype* The archetype, nullptr if the entity has no component.
+		 */
+		Archetype* GetArchetype(EntityID entityId) const;
+
+		/**
+		 * @brief Get the number of archetypes created so far.
+		 *
+		 * @return size_t Number of archetypes.
+		 */
+		size_t GetArchetypeCount() const { return m_archetypeList.size(); }
+
+		/**
+		 * @brief Call func(Archetype&) on every non-empty archetype including the required components.
+		 *
+		 * @param required The components the archetypes must have.
+		 * @param func The function to call.
+		 */
+		template<typename Func> void ForEachArchetype(const Signature& required, Func&& func) const { ForEachArchetype(required, Signature(), std::forward<Func>(func)); }
+
+		/**
+		 * @brief Call func(Archetype&) on every non-empty archetype including the required components and none of the excluded ones.
+		 *
+		 * @param required The components the archetypes must have.
+		 * @param excluded The components the archetypes must not have.
+		 * @param func The function to call.
+		 */
+		template<typename Func> void ForEachArchetype(const Signature& required, const Signature& excluded, Func&& func) const;
+
+	private:
+		struct EntityLocation
+		{
+			Archetype* archetype = nullptr;
+			u32 row = 0;
+		};
+
+		struct SignatureHasher
+		{
+			size_t operator()(const Signature& signature) const { return signature.Hash(); }
+		};
+
+		template<typename T> void RegisterComponent(u32 componentId);
+
+		EntityLocation& GetLocation(EntityID entityId);
+		Archetype* GetOrCreateArchetype(const Signature& signature);
+		Archetype* GetAddTarget(Archetype* source, u32 componentId);
+		Archetype* GetRemoveTarget(Archetype* source, u32 componentId);
+
+		// Move an entity to target, moving the components both archetypes share.
+		// The components only target has are left uninitialized.
+		u32 MoveEntity(EntityID entityId, Archetype* target);
+		void RemoveRow(Archetype* archetype, u32 row);
+
+	private:
+		// [vector index = componentId], stable addresses (sized MAX_COMPONENTS once)
+		std::pmr::vector<ComponentInfo> m_componentInfos;
+
+		std::pmr::unordered_map<Signature, ResourcePtr<Archetype>, SignatureHasher> m_archetypes;
+		// Archetypes in creation order, for deterministic iteration
+		std::pmr::vector<Archetype*> m_archetypeList;
+
+		// [vector index = entity index]
+		std::pmr::vector<EntityLocation> m_locations;
+
+		std::pmr::memory_resource* m_resource;
+	};
+
+	template<typename T>
+	T& ArchetypeStorage::Add(EntityID entityId, u32 componentId, T&& component)
+	{
+		RegisterComponent<T>(componentId);
+
+		EntityLocation& location = GetLocation(entityId);
+		if (location.archetype)
+		{
+			const int column = location.archetype->GetColumn(componentId);
+			if (column != -1)
+			{
+				T& existing = *static_cast<T*>(location.archetype->GetComponent(location.row, column));
+				existing = std::move(component);
+				return existing;
+			}
+		}
+
+		Archetype* target = GetAddTarget(location.archetype, componentId);
+		const u32 row = MoveEntity(entityId, target);
+
+		return *new (target->GetComponent(row, target->GetColumn(componentId))) T(std::move(component));
+	}
+
+	template<typename Func>
+	void ArchetypeStorage::ForEachArchetype(const Signature& required, const Signature& excluded, Func&& func) const
+	{
+		for (Archetype* archetype : m_archetypeList)
+		{
+			if (archetype->GetEntityCount() && archetype->GetSignature().Contains(required) && !archetype->GetSignature().Intersects(excluded))
+				func(*archetype);
+		}
+	}
+
+	template<typename T>
+	void ArchetypeStorage::RegisterComponent(u32 componentId)
+	{
+		if (!m_componentInfos[componentId].destroy)
+			m_componentInfos[componentId] = ComponentInfo::Create<T>(componentId);
+	}
+}
\ No newline at end of file
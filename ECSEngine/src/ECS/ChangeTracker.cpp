@@ -0,0 +1,110 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ChangeTracker.h"
+
+namespace ECS
+{
+	ChangeTracker::ChangeTracker(const u32& currentTick, size_t size, std::pmr::memory_resource* resource)
+		: m_currentTick(&currentTick), m_addedTicks(size, 0, resource), m_changedTicks(size, 0, resource), m_removals(resource)
+	{
+	}
+
+	std::span<const ChangeTracker::Removal> ChangeTracker::GetRemovals(u32 sinceTick) const
+	{
+		auto first = std::lower_bound(m_removals.begin(), m_removals.end(), sinceTick,
+			[](const Removal& removal, u32 tick) { return removal.tick < tick; });
+
+		return std::span<const Removal>(first, m_removals.end());
+	}
+
+	void ChangeTracker::DiscardRemovals(u32 beforeTick)
+	{
+		auto first = std::lower_bound(m_removals.begin(), m_removals.end(), beforeTick,
+			[](const Removal& removal, u32 tick) { return removal.tick < tick; });
+
+		m_removals.erase(m_removals.begin(), first);
+	}
+
+	void ChangeTracker::OnAdded()
+	{
+		m_addedTicks.push_back(*m_currentTick);
+		m_changedTicks.push_back(*m_currentTick);
+	}
+
+	void ChangeTracker::OnRemoved(EntityID entityId, u32 packedIndex)
+	{
+		// Same swap-and-pop as the pool
+		m_addedTicks[packedIndex] = m_addedTicks.back();
+		m_changedTicks[packedIndex] = m_changedTicks.back();
+		m_addedTicks.pop_back();
+		m_changedTicks.pop_back();
+
+		m_removals.push_back({ entityId, *m_currentTick });
+	}
+
+	void ChangeTracker::OnMoved(u32 from, u32 to)
+	{
+		m_addedTicks[to] = m_addedTicks[from];
+		m_changedTicks[to] = m_changedTicks[from];
+	}
+
+	void ChangeTracker::OnTruncated(size_t size)
+	{
+		m_addedTicks.resize(size);
+		m_changedTicks.resize(size);
+	}
+
+	void ChangeTracker::OnSwapped(u32 a, u32 b)
+	{
+		std::swap(m_addedTicks[a], m_addedTicks[b]);
+		std::swap(m_changedTicks[a], m_changedTicks[b]);
+	}
+
+	void ChangeTracker::CopyFrom(const ChangeTracker* other, size_t size)
+	{
+		if (other)
+		{
+			m_addedTicks = other->m_addedTicks;
+			m_changedTicks = other->m_changedTicks;
+			m_removals = other->m_removals;
+		}
+		else
+		{
+			m_addedTicks.assign(size, 0);
+			m_changedTicks.assign(size, 0);
+			m_removals.clear();
+		}
+	}
+
+	void ChangeTracker::OnCleared(std::span<const EntityID> entities)
+	{
+		for (EntityID entityId : entities)
+			m_removals.push_back({ entityId, *m_currentTick });
+
+		m_addedTicks.clear();
+		m_changedTicks.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+
+namespace ECS
+{
+	// View filters (see Registry::ViewSince()), wrapping a component type:
+	// View<Changed<Position>, Velocity>(...) only visits the entities whose Position changed.
+	template<typename T> struct Added {}; // Component added since the tick
+	template<typename T> struct Changed {}; // Component added or changed since the tick
+	template<typename T> struct Removed {}; // Component removed since the tick (viewed alone, ids only)
+
+	enum class ViewFilterKind
+	{
+		None,
+		Added,
+		Changed,
+		Removed
+	};
+
+	template<typename T> struct ViewFilter { using Component = T; static constexpr ViewFilterKind kind = ViewFilterKind::None; };
+	template<typename T> struct ViewFilter<Added<T>> { using Component = T; static constexpr ViewFilterKind kind = ViewFilterKind::Added; };
+	template<typename T> struct ViewFilter<Changed<T>> { using Component = T; static constexpr ViewFilterKind kind = ViewFilterKind::Changed; };
+	template<typename T> struct ViewFilter<Removed<T>> { using Component = T; static constexpr ViewFilterKind kind = ViewFilterKind::Removed; };
+
+	// Component type behind a view argument, filter or not. A const type (const T, Changed<const T>)
+	// is viewed read-only: passed as const T&, its pool is not touched (see IPool::Touch())
+	template<typename T> using FilteredComponent = std::remove_const_t<typename ViewFilter<std::remove_const_t<T>>::Component>;
+	template<typename T> constexpr bool IsViewFilter = ViewFilter<std::remove_const_t<T>>::kind != ViewFilterKind::None;
+	template<typename T> constexpr bool IsReadOnlyViewTerm = std::is_const_v<T> || std::is_const_v<typename ViewFilter<std::remove_const_t<T>>::Component>;
+
+	// Per-pool change ticks, enabled with Registry::EnableChangeTracking().
+	// Keeps the tick a component was added and last changed at, in the pool packed order,
+	// and a log of removals. Ticks are compared, never cleared: a frame costs nothing.
+	class ChangeTracker
+	{
+	public:
+		struct Removal
+		{
+			EntityID entityId;
+			u32 tick;
+		};
+
+		/**
+		 * @brief Construct a new ChangeTracker object.
+		 *
+		 * @param currentTick The registry tick, read on every change.
+		 * @param size Number of components already in the pool (stamped with tick 0).
+		 * @param resource Memory resource of the tick arrays and the removal log.
+		 */
+		ChangeTracker(const u32& currentTick, size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		u32 GetAddedTick(u32 packedIndex) const { return m_addedTicks[packedIndex]; }
+		u32 GetChangedTick(u32 packedIndex) const { return m_changedTicks[packedIndex]; }
+
+		/**
+		 * @brief Get the removals logged at or after a tick.
+		 *
+		 * @param sinceTick First tick to include.
+		 * @return std::span<const Removal> The removals, oldest first.
+		 */
+		std::span<const Removal> GetRemovals(u32 sinceTick) const;
+
+		/**
+		 * @brief Forget the removals logged before a tick.
+		 *
+		 * @param beforeTick First tick to keep.
+		 */
+		void DiscardRemovals(u32 beforeTick);
+
+		// Mirror of the pool packed array operations
+		void OnAdded();
+		void OnChanged(u32 packedIndex) { m_changedTicks[packedIndex] = *m_currentTick; }
+		void OnRemoved(EntityID entityId, u32 packedIndex);
+		// Batched removal: log each removed entity, move the kept ones into the holes, then truncate
+		void OnRemoving(EntityID entityId) { m_removals.push_back({ entityId, *m_currentTick }); }
+		void OnMoved(u32 from, u32 to);
+		void OnTruncated(size_t size);
+		void OnSwapped(u32 a, u32 b);
+		void OnCleared(std::span<const EntityID> entities);
+
+		/**
+		 * @brief Copy the ticks and removals of another tracker, keeping the registry tick of this one.
+		 *
+		 * @param other The tracker to copy, nullptr to stamp every component with tick 0.
+		 * @param size Number of components in the pool after the copy.
+		 */
+		void CopyFrom(const ChangeTracker* other, size_t size);
+
+	private:
+		const u32* m_currentTick;
+		std::pmr::vector<u32> m_addedTicks;
+		std::pmr::vector<u32> m_changedTicks;
+		std::pmr::vector<Removal> m_removals; // In tick order
+	};
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "CommandBuffer.h"
+
+namespace ECS
+{
+	Entity CommandBuffer::CreateEntity()
+	{
+		return Entity(CreateEntityId(m_createdCount++, PLACEHOLDER_VERSION));
+	}
+
+	void CommandBuffer::KillEntity(Entity e)
+	{
+		m_commands.push_back({ CommandType::Kill, 0, e.GetId(), 0 });
+	}
+
+	void CommandBuffer::Clear()
+	{
+		m_createdCount = 0;
+		m_commands.clear();
+		for (auto& storage : m_storages)
+		{
+			if (storage)
+				storage->Clear();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+#include "Entity.h"
+#include "Component.h"
+
+namespace ECS
+{
+	class Registry;
+
+	// Records structural changes (spawns, kills, component adds/removes) to apply later, see
+	// Registry::CreateCommandBuffer(). Recording only touches the buffer itself, so each thread
+	// can fill its own buffer without locks while a ParallelView runs.
+	class CommandBuffer
+	{
+	public:
+		CommandBuffer() = default;
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+		/**
+		 * @brief Record the creation of an entity.
+		 *
+		 * @return Entity A placeholder, only meaningful to this buffer: it can be passed to the
+		 *	other commands and is replaced by the real entity at playback.
+		 */
+		Entity CreateEntity();
+
+		/**
+		 * @brief Record the destruction of an entity (or placeholder).
+		 *
+		 * @param e The entity to destroy.
+		 */
+		void KillEntity(Entity e);
+
+		/**
+		 * @brief Record the addition of a component to an entity (or placeholder).
+		 *
+		 * @tparam T Component type to add.
+		 * @tparam TArgs Constructor argument types for T.
+		 * @param e The entity to which the component will be added.
+		 * @param args Arguments forwarded to T's constructor, now.
+		 */
+		template<typename T, typename ...TArgs> void AddComponent(Entity e, TArgs&& ...args);
+
+		/**
+		 * @brief Record the removal of a component from an entity (or placeholder).
+		 *
+		 * @tparam T Component type to remove.
+		 * @param e The entity from which the component will be removed.
+		 */
+		template<typename T> void RemoveComponent(Entity e);
+
+		bool IsEmpty() const { return m_commands.empty() && m_createdCount == 0; }
+
+		/**
+		 * @brief Drop every recorded command, keeping the allocations.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Check whether an entity id is a placeholder returned by CreateEntity().
+		 *
+		 * @param entityId Full entity id.
+		 * @return true If the id is a placeholder.
+		 * @return false Otherwise.
+		 */
+		static bool IsPlaceholder(EntityID entityId) { return GetEntityVersion(entityId) == PLACEHOLDER_VERSION; }
+
+	private:
+		friend class Registry;
+
+		// Placeholders use a version real entities never reach (index = creation order in the buffer)
+		static constexpr u32 PLACEHOLDER_VERSION = u32_invalid_id;
+
+		enum class CommandType : u8
+		{
+			Kill,
+			AddComponent,
+			RemoveComponent
+		};
+
+		struct Command
+		{
+			CommandType type;
+			u32 componentId;
+			EntityID entityId;
+			u32 valueIndex; // Index of the component value in its storage (AddComponent)
+		};
+
+		// Typed component values and the typed Registry calls to apply them
+		struct IComponentStorage
+		{
+			virtual ~IComponentStorage() = default;
+			virtual size_t GetSize() const = 0;
+			virtual void Reserve(Registry& registry, size_t count) = 0;
+			virtual void Add(Registry& registry, Entity e, u32 valueIndex) = 0;
+			virtual void Remove(Registry& registry, Entity e) = 0;
+			virtual void Clear() = 0;
+		};
+
+		template<typename T>
+		struct ComponentStorage final : IComponentStorage
+		{
+			std::vector<T> values;
+
+			size_t GetSize() const override { return values.size(); }
+			void Reserve(Registry& registry, size_t count) override;
+			void Add(Registry& registry, Entity e, u32 valueIndex) override;
+			void Remove(Registry& registry, Entity e) override;
+			void Clear() override { values.clear(); }
+		};
+
+		template<typename T> ComponentStorage<T>& GetStorage();
+
+	private:
+		u32 m_createdCount = 0;
+		std::vector<Command> m_commands;
+		std::vector<std::unique_ptr<IComponentStorage>> m_storages; // [vector index = Component<T>::GetId()], not the registry id
+	};
+
+	template<typename T, typename ...TArgs>
+	void CommandBuffer::AddComponent(Entity e, TArgs&& ...args)
+	{
+		ComponentStorage<T>& storage = GetStorage<T>();
+		storage.values.emplace_back(std::forward<TArgs>(args)...);
+		m_commands.push_back({ CommandType::AddComponent, (u32)Component<T>::GetId(), e.GetId(), (u32)storage.values.size() - 1 });
+	}
+
+	template<typename T>
+	void CommandBuffer::RemoveComponent(Entity e)
+	{
+		GetStorage<T>();
+		m_commands.push_back({ CommandType::RemoveComponent, (u32)Component<T>::GetId(), e.GetId(), 0 });
+	}
+
+	template<typename T>
+	CommandBuffer::ComponentStorage<T>& CommandBuffer::GetStorage()
+	{
+		const auto componentId = Component<T>::GetId();
+		if (componentId >= m_storages.size())
+			m_storages.resize(componentId + 1);
+
+		if (!m_storages[componentId])
+			m_storages[componentId] = std::make_unique<ComponentStorage<T>>();
+
+		return static_cast<ComponentStorage<T>&>(*m_storages[componentId]);
+	}
+}
\ No newline at end of file
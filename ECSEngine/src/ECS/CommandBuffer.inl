@@ -0,0 +1,23 @@
+// Implementation of CommandBuffer template methods
+// Included from Registry.h after Registry is defined
+
+namespace ECS
+{
+	template<typename T>
+	void CommandBuffer::ComponentStorage<T>::Reserve(Registry& registry, size_t count)
+	{
+		registry.template ReserveComponents<T>(count);
+	}
+
+	template<typename T>
+	void CommandBuffer::ComponentStorage<T>::Add(Registry& registry, Entity e, u32 valueIndex)
+	{
+		registry.template AddComponent<T>(e, std::move(values[valueIndex]));
+	}
+
+	template<typename T>
+	void CommandBuffer::ComponentStorage<T>::Remove(Registry& registry, Entity e)
+	{
+		registry.template RemoveComponent<T>(e);
+	}
+}
@@ -25,21 +25,49 @@ SOFTWARE.
 #pragma once
 
 #include "PrimitiveTypes.h"
+#include "Signature.h"
 
-#include <bitset>
+#include <vector>
+#include <algorithm>
 #include <unordered_map>
 #include <typeindex>
 #include <set>
 #include <memory>
+#include <memory_resource>
 #include <deque>
+#include <span>
 #include <cassert>
 
 namespace ECS
 {
-	constexpr unsigned int MAX_COMPONENTS = 32;
+	// Maximum number of component types, set with the ECS_MAX_COMPONENTS CMake option
+#ifndef ECS_MAX_COMPONENTS
+#define ECS_MAX_COMPONENTS 64
+#endif
+	constexpr unsigned int MAX_COMPONENTS = ECS_MAX_COMPONENTS;
+
+	// Number of component ids reserved for StaticComponentId, set with the ECS_STATIC_COMPONENT_IDS CMake option.
+	// Runtime ids are handed out after them.
+#ifndef ECS_STATIC_COMPONENT_IDS
+#define ECS_STATIC_COMPONENT_IDS 8
+#endif
+	constexpr unsigned int STATIC_COMPONENT_IDS = ECS_STATIC_COMPONENT_IDS;
+	static_assert(STATIC_COMPONENT_IDS <= MAX_COMPONENTS, "ECS_STATIC_COMPONENT_IDS must not exceed ECS_MAX_COMPONENTS");
 	constexpr unsigned int MAX_ENTITIES = 1000000;
 	constexpr unsigned int DEFAULT_CAPACITY = 1000;
-	constexpr size_t PAGE_SIZE = 4096;
+	constexpr size_t PAGE_SIZE = 4096; // Default number of entities per sparse page (see Registry::SetPoolPageSize)
+	constexpr size_t DEFAULT_GRAIN_SIZE = 4096; // Entities per chunk in ParallelView
+	constexpr size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024; // Bytes per archetype chunk
+	constexpr size_t CACHE_LINE_SIZE = 64;
+	constexpr size_t CHUNK_BATCH_SIZE = 1024; // Components per ForEachChunk batch in StorageMode::SparseSet
+	static_assert(CHUNK_BATCH_SIZE % CACHE_LINE_SIZE == 0, "Batches must keep every component span aligned");
+
+	// How a Registry stores its components
+	enum class StorageMode
+	{
+		SparseSet, // One sparse-set Pool per component type (default)
+		Archetype // Entities grouped by Signature in chunked SoA archetypes
+	};
 
 	using EntityID = u64;
 
@@ -49,9 +77,19 @@ namespace ECS
 
 	// We use a bitset (1s and 0s) to keep track of which components an entity has,
 	// and also helps keep track of which entities a system is interested in.
-	typedef std::bitset<MAX_COMPONENTS> Signature;
+	typedef BasicSignature<MAX_COMPONENTS> Signature;
 
 	inline u32 GetEntityIndex(EntityID id) { return id & ENTITY_INDEX_MASK; }
 	inline u32 GetEntityVersion(EntityID id) { return (id & ENTITY_VERSION_MASK) >> ENTITY_VERSION_SHIFT; }
 	inline EntityID CreateEntityId(u32 index, u32 version) { return ((u64)version << ENTITY_VERSION_SHIFT) | index; }
+
+	// Highest version of an entity index, u32_invalid_id is reserved (command buffer placeholders, retired indices)
+	constexpr u32 MAX_ENTITY_VERSION = u32_invalid_id - 1;
+
+	// What a Registry does with an entity index killed at its highest version, see Registry::SetVersionOverflow()
+	enum class VersionOverflow
+	{
+		Wrap, // The next entity of the index gets version 0 again (default)
+		Retire // The index is never reused, so that no old handle can match a new entity
+	};
 }
\ No newline at end of file
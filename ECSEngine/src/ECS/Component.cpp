@@ -26,5 +26,5 @@ SOFTWARE.
 
 namespace ECS
 {
-	u64 IComponent::nextId = 0;
+	std::atomic<u64> IComponent::nextId = STATIC_COMPONENT_IDS;
 }
\ No newline at end of file
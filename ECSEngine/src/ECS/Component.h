@@ -27,17 +27,103 @@ SOFTWARE.
 #include "Common.h"
 #include "IComponent.h"
 
+#include <string_view>
+#include <concepts>
+
 namespace ECS
 {
+	// Optional compile-time component id, in [0, ECS_STATIC_COMPONENT_IDS):
+	//	template<> struct ECS::StaticComponentId<Transform> { static constexpr u32 value = 0; };
+	// or ECS_STATIC_COMPONENT_ID(Transform, 0) at global scope.
+	// GetId() is then a constant the compiler folds into the registry id lookup (Registry::GetComponentId()).
+	template<typename T> struct StaticComponentId;
+
+	template<typename T>
+	concept HasStaticComponentId = requires { { StaticComponentId<T>::value } -> std::convertible_to<u32>; };
+
+	// Type name as written by the compiler, e.g. "Transform" or "game::Transform"
+	template<typename T>
+	constexpr std::string_view GetTypeName()
+	{
+#if defined(_MSC_VER)
+		constexpr std::string_view function = __FUNCSIG__;
+		constexpr std::string_view prefix = "GetTypeName<";
+		constexpr std::string_view suffix = ">(void)";
+#else
+		constexpr std::string_view function = __PRETTY_FUNCTION__;
+		constexpr std::string_view prefix = "T = ";
+		constexpr std::string_view suffix = "]";
+#endif
+		constexpr size_t begin = function.find(prefix) + prefix.size();
+		std::string_view name = function.substr(begin, function.rfind(suffix) - begin);
+
+		// GCC appends the aliases in use ("T = Foo; std::string_view = ...")
+		const size_t separator = name.find(';');
+		if (separator != std::string_view::npos)
+			name = name.substr(0, separator);
+
+#if defined(_MSC_VER)
+		for (std::string_view keyword : { "struct ", "class ", "enum " })
+		{
+			if (name.starts_with(keyword))
+				name.remove_prefix(keyword.size());
+		}
+#endif
+		return name;
+	}
+
 	// Used to assign a unique id to a component type
 	template<typename T>
 	class Component : public IComponent
 	{
 	public:
-		static u64 GetId()
+		/**
+		 * @brief Get the component id, a constant for types with a StaticComponentId.
+		 *	Process-wide type key, each Registry maps it to its own compact ids (see Registry::GetComponentId()).
+		 * @return u64 The component id.
+		 */
+		static constexpr u64 GetId() requires HasStaticComponentId<T>
+		{
+			static_assert(StaticComponentId<T>::value < STATIC_COMPONENT_IDS, "Static component ids must be below ECS_STATIC_COMPONENT_IDS");
+			return StaticComponentId<T>::value;
+		}
+
+		/**
+		 * @brief Get the component id, assigned on first use (the order can change between runs).
+		 *
+		 * @return u64 The component id.
+		 */
+		static u64 GetId() requires (!HasStaticComponentId<T>)
 		{
 			static u64 id = nextId++;
 			return id;
 		}
+
+		/**
+		 * @brief Get the name of the component type.
+		 *
+		 * @return std::string_view The type name.
+		 */
+		static constexpr std::string_view GetTypeName() { return ECS::GetTypeName<T>(); }
+
+		/**
+		 * @brief Get a hash of the component type name (FNV-1a), identical for every run and
+		 *	every module built with the same compiler, unlike GetId() for runtime ids.
+		 * @return u64 The type hash.
+		 */
+		static constexpr u64 GetTypeHash()
+		{
+			u64 hash = 14695981039346656037ull;
+			for (char c : GetTypeName())
+			{
+				hash ^= (u8)c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
 	};
-}
\ No newline at end of file
+}
+
+// Register a compile-time component id (see ECS::StaticComponentId), at global scope
+#define ECS_STATIC_COMPONENT_ID(Type, Id) \
+	template<> struct ECS::StaticComponentId<Type> { static constexpr u32 value = Id; }
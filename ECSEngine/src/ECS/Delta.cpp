@@ -0,0 +1,135 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "Delta.h"
+#include "Registry.h"
+
+namespace ECS
+{
+	void Registry::WriteDeltaEntities(DeltaWriter& writer, u32 sinceTick, u32 poolCount) const
+	{
+		std::vector<EntityID> created;
+		std::vector<EntityID> destroyed;
+
+		if (sinceTick == 0)
+		{
+			// Full state: every alive entity, nothing to destroy
+			for (u32 index = 0; index < (u32)m_numEntities; ++index)
+			{
+				if (IsSlotAlive(index))
+					created.push_back(m_entitySlots[index]);
+			}
+		}
+		else
+		{
+			// Entities created then killed in the window are only sent as destroyed, the receiver skips them
+			for (const EntityLogEntry& entry : m_createdEntityLog)
+			{
+				if (entry.tick >= sinceTick && IsValid(Entity(entry.entityId, nullptr)))
+					created.push_back(entry.entityId);
+			}
+			for (const EntityLogEntry& entry : m_killedEntityLog)
+			{
+				if (entry.tick >= sinceTick)
+					destroyed.push_back(entry.entityId);
+			}
+		}
+
+		DeltaHeader header;
+		header.sinceTick = sinceTick;
+		header.tick = m_currentTick;
+		header.createdCount = (u32)created.size();
+		header.destroyedCount = (u32)destroyed.size();
+		header.poolCount = poolCount;
+		writer.Write(&header, sizeof(header));
+		writer.Write(created.data(), created.size() * sizeof(EntityID));
+		writer.Write(destroyed.data(), destroyed.size() * sizeof(EntityID));
+	}
+
+	bool Registry::ApplyDeltaEntities(DeltaReader& reader, const DeltaHeader& header)
+	{
+		const u8* created = reader.Read(header.createdCount * sizeof(EntityID));
+		const u8* destroyed = reader.Read(header.destroyedCount * sizeof(EntityID));
+		if (!created || !destroyed)
+			return false;
+
+		// Destroyed right away, the sender may have reused their indices for the created entities
+		for (u32 i = 0; i < header.destroyedCount; ++i)
+		{
+			const Entity e(DeltaReader::Get<EntityID>(destroyed, i), this);
+			if (IsValid(e))
+				DestroyEntity(e);
+		}
+		FlushPoolRemovals();
+
+		if (!header.createdCount)
+			return true;
+
+		// The free list is rebuilt once below instead of unlinking every adopted index from it
+		std::vector<u32> freeIndices;
+		freeIndices.reserve(m_freeCount);
+		for (u32 index = m_freeHead; index != u32_invalid_id; index = GetEntityIndex(m_entitySlots[index]))
+			freeIndices.push_back(index);
+		const u32 previousCount = (u32)m_numEntities;
+
+		for (u32 i = 0; i < header.createdCount; ++i)
+			AdoptEntity(DeltaReader::Get<EntityID>(created, i));
+
+		// Pushed last first to keep their order, then the indices skipped by the sender
+		m_freeHead = u32_invalid_id;
+		m_freeCount = 0;
+		for (size_t i = freeIndices.size(); i-- > 0;)
+		{
+			if (!IsSlotAlive(freeIndices[i]))
+				PushFreeIndex(freeIndices[i], GetEntityVersion(m_entitySlots[freeIndices[i]]));
+		}
+		for (u32 index = previousCount; index < (u32)m_numEntities; ++index)
+		{
+			if (!IsSlotAlive(index))
+				PushFreeIndex(index, GetEntityVersion(m_entitySlots[index]));
+		}
+
+		return true;
+	}
+
+	void Registry::AdoptEntity(EntityID entityId)
+	{
+		if (IsValid(Entity(entityId, this)))
+			return;
+
+		const u32 index = GetEntityIndex(entityId);
+		if (index >= (u32)m_numEntities)
+		{
+			// The indices skipped by the sender are left free (see ApplyDeltaEntities())
+			GrowEntities((size_t)index + 1);
+			m_numEntities = (int)index + 1;
+		}
+		else
+			assert(!IsSlotAlive(index) && "Entity index still alive, call Update() between deltas");
+
+		m_entitySlots[index] = entityId;
+		m_systemSyncPending[index] = true;
+		m_entitiesToBeAdded.emplace_back(entityId, this);
+	}
+}
@@ -0,0 +1,173 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Common.h"
+
+#include <cstring>
+
+namespace ECS
+{
+	// Delta format (see Registry::WriteDelta), native endianness, unpadded:
+	// DeltaHeader, created entity ids (EntityID[createdCount]), destroyed entity ids (EntityID[destroyedCount]),
+	// then per pool a DeltaPoolHeader, the entities that lost the component (EntityID[removedCount]),
+	// the entities whose component was added or changed (EntityID[changedCount]) and their values (T[changedCount]).
+	constexpr u32 DELTA_MAGIC = 0x444C4345; // "ECLD"
+	constexpr u32 DELTA_VERSION = 2;
+
+	struct DeltaHeader
+	{
+		u32 magic = DELTA_MAGIC;
+		u32 version = DELTA_VERSION;
+		u32 sinceTick = 0; // First tick included
+		u32 tick = 0; // Sender tick when the delta was written
+		u32 createdCount = 0;
+		u32 destroyedCount = 0;
+		u32 poolCount = 0;
+		u32 reserved = 0;
+	};
+
+	struct DeltaPoolHeader
+	{
+		u64 typeHash = 0; // Component<T>::GetTypeHash()
+		u32 componentSize = 0;
+		u32 removedCount = 0;
+		u32 changedCount = 0;
+		u32 reserved = 0;
+	};
+
+	// Appends delta blocks to a byte buffer
+	class DeltaWriter
+	{
+	public:
+		/**
+		 * @brief Construct a writer appending to a buffer.
+		 *
+		 * @param buffer The destination buffer.
+		 */
+		explicit DeltaWriter(std::vector<u8>& buffer) : m_buffer(buffer) {}
+
+		/**
+		 * @brief Append a block.
+		 *
+		 * @param data Block data.
+		 * @param size Block size in bytes.
+		 */
+		void Write(const void* data, size_t size)
+		{
+			if (size)
+				m_buffer.insert(m_buffer.end(), static_cast<const u8*>(data), static_cast<const u8*>(data) + size);
+		}
+
+		/**
+		 * @brief Append a zeroed block, to be written later with WriteAt() (e.g. a header with counts).
+		 *
+		 * @param size Block size in bytes.
+		 * @return size_t Offset of the block in the buffer.
+		 */
+		size_t Skip(size_t size)
+		{
+			m_buffer.resize(m_buffer.size() + size);
+			return m_buffer.size() - size;
+		}
+
+		/**
+		 * @brief Overwrite a block appended with Skip().
+		 *
+		 * @param offset Offset returned by Skip().
+		 * @param data Block data.
+		 * @param size Block size in bytes.
+		 */
+		void WriteAt(size_t offset, const void* data, size_t size) { std::memcpy(m_buffer.data() + offset, data, size); }
+
+	private:
+		std::vector<u8>& m_buffer;
+	};
+
+	// Sequential reader of delta blocks. Blocks are not aligned: values are copied out with Get().
+	class DeltaReader
+	{
+	public:
+		/**
+		 * @brief Construct a reader over a delta.
+		 *
+		 * @param delta Delta bytes.
+		 */
+		explicit DeltaReader(std::span<const u8> delta) : m_delta(delta) {}
+
+		/**
+		 * @brief Get the next block and skip it.
+		 *
+		 * @param size Block size in bytes.
+		 * @return const u8* The block, nullptr if the delta is too short.
+		 */
+		const u8* Read(size_t size)
+		{
+			if (m_offset + size > m_delta.size())
+				return nullptr;
+
+			const u8* block = m_delta.data() + m_offset;
+			m_offset += size;
+			return block;
+		}
+
+		/**
+		 * @brief Copy the next value out of the delta.
+		 *
+		 * @param value The destination.
+		 * @return true If the value was read.
+		 * @return false If the delta is too short.
+		 */
+		template<typename T>
+		bool Read(T& value)
+		{
+			const u8* block = Read(sizeof(T));
+			if (!block)
+				return false;
+
+			std::memcpy(&value, block, sizeof(T));
+			return true;
+		}
+
+		/**
+		 * @brief Copy the element of an unaligned array read with Read(size).
+		 *
+		 * @param block The array.
+		 * @param index Element index.
+		 * @return T The element.
+		 */
+		template<typename T>
+		static T Get(const u8* block, size_t index)
+		{
+			T value;
+			std::memcpy(&value, block + index * sizeof(T), sizeof(T));
+			return value;
+		}
+
+	private:
+		std::span<const u8> m_delta;
+		size_t m_offset = 0;
+	};
+}
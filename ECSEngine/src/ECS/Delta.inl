@@ -0,0 +1,162 @@
+// Implementation of Registry delta template methods
+// Included from Registry.h after Registry is defined
+
+namespace ECS
+{
+	template<typename... Components>
+	void Registry::WriteDelta(u32 sinceTick, std::vector<u8>& out) const
+	{
+		static_assert(((std::is_trivially_copyable_v<Components> && !SoAComponent<Components>) && ...),
+			"Delta components must be trivially copyable and use the default pool");
+		assert(m_storageMode == StorageMode::SparseSet && "Deltas need StorageMode::SparseSet");
+		assert((sinceTick == 0 || sinceTick + 1 >= m_currentTick) && "Removals are only kept until the end of the next Update()");
+
+		DeltaWriter writer(out);
+		WriteDeltaEntities(writer, sinceTick, (u32)sizeof...(Components));
+
+		auto writePool = [this, sinceTick, &writer]<typename T>() {
+			const Pool<T>* pool = GetPool<T>();
+			const ChangeTracker* tracker = pool ? pool->GetChangeTracker() : nullptr;
+			assert((!pool || tracker) && "WriteDelta() needs EnableChangeTracking() on every component type");
+
+			DeltaPoolHeader header;
+			header.typeHash = Component<T>::GetTypeHash();
+			header.componentSize = (u32)ComponentDataSize<T>;
+			const size_t headerOffset = writer.Skip(sizeof(header));
+
+			if (tracker)
+			{
+				// Components of killed entities go with the destroyed records
+				if (sinceTick != 0)
+				{
+					for (const ChangeTracker::Removal& removal : tracker->GetRemovals(sinceTick))
+					{
+						if (IsValid(Entity(removal.entityId, nullptr)) && !pool->Has(removal.entityId))
+						{
+							writer.Write(&removal.entityId, sizeof(EntityID));
+							header.removedCount++;
+						}
+					}
+				}
+
+				// Runs of changed slots in packed order, each copied with one memcpy
+				std::vector<std::pair<u32, u32>> runs;
+				const u32 size = (u32)pool->GetSize();
+				for (u32 i = 0; i < size; ++i)
+				{
+					if (tracker->GetChangedTick(i) < sinceTick)
+						continue;
+
+					if (!runs.empty() && runs.back().second == i)
+						runs.back().second++;
+					else
+						runs.push_back({ i, i + 1 });
+					header.changedCount++;
+				}
+
+				const EntityID* entities = pool->GetEntities().data();
+				for (const auto& [begin, end] : runs)
+					writer.Write(entities + begin, (end - begin) * sizeof(EntityID));
+
+				if constexpr (!EmptyComponent<T>)
+				{
+					const T* data = std::as_const(*pool).GetData().data();
+					for (const auto& [begin, end] : runs)
+						writer.Write(data + begin, (end - begin) * sizeof(T));
+				}
+			}
+
+			writer.WriteAt(headerOffset, &header, sizeof(header));
+		};
+		(writePool.template operator()<Components>(), ...);
+	}
+
+	template<typename... Components>
+	bool Registry::ApplyDelta(std::span<const u8> delta)
+	{
+		static_assert(((std::is_trivially_copyable_v<Components> && !SoAComponent<Components>) && ...),
+			"Delta components must be trivially copyable and use the default pool");
+		assert(m_storageMode == StorageMode::SparseSet && "Deltas need StorageMode::SparseSet");
+
+		DeltaReader reader(delta);
+		DeltaHeader header;
+		if (!reader.Read(header) || header.magic != DELTA_MAGIC || header.version != DELTA_VERSION)
+			return false;
+
+		if (!ApplyDeltaEntities(reader, header))
+			return false;
+
+		for (u32 i = 0; i < header.poolCount; ++i)
+		{
+			DeltaPoolHeader poolHeader;
+			if (!reader.Read(poolHeader))
+				return false;
+
+			const u8* removed = reader.Read(poolHeader.removedCount * sizeof(EntityID));
+			const u8* changed = reader.Read(poolHeader.changedCount * sizeof(EntityID));
+			const u8* values = reader.Read((size_t)poolHeader.changedCount * poolHeader.componentSize);
+			if (!removed || !changed || !values)
+				return false;
+
+			// One pool lookup and one reserve per pool, pools of types that are not listed are skipped
+			bool valid = true;
+			auto applyPool = [&]<typename T>() {
+				if (poolHeader.typeHash != Component<T>::GetTypeHash())
+					return;
+
+				if (poolHeader.componentSize != ComponentDataSize<T>)
+				{
+					valid = false;
+					return;
+				}
+
+				Pool<T>* pool = GetOrCreatePool<T>();
+				const u32 componentId = GetComponentId<T>();
+
+				for (u32 j = 0; j < poolHeader.removedCount; ++j)
+				{
+					const EntityID entityId = DeltaReader::Get<EntityID>(removed, j);
+					if (IsValid(Entity(entityId, this)) && pool->Has(entityId))
+					{
+						pool->Remove(entityId);
+						OnComponentRemoved(entityId, componentId);
+					}
+				}
+
+				pool->Reserve(pool->GetSize() + poolHeader.changedCount);
+				for (u32 j = 0; j < poolHeader.changedCount; ++j)
+				{
+					const EntityID entityId = DeltaReader::Get<EntityID>(changed, j);
+					if (!IsValid(Entity(entityId, this)))
+					{
+						valid = false;
+						return;
+					}
+
+					T value = [&]() {
+						if constexpr (EmptyComponent<T>)
+							return T{};
+						else
+							return DeltaReader::Get<T>(values, j);
+						}();
+					if (pool->Has(entityId))
+					{
+						pool->Set(entityId, value);
+						QueueComponentEvent(ComponentEvent::Update, componentId, entityId);
+					}
+					else
+					{
+						pool->Add(entityId, value);
+						OnComponentAdded(entityId, componentId);
+					}
+				}
+			};
+			(applyPool.template operator()<Components>(), ...);
+
+			if (!valid)
+				return false;
+		}
+
+		return true;
+	}
+}
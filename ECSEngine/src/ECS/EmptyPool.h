@@ -0,0 +1,281 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Common.h"
+
+namespace ECS
+{
+	// Components without data, e.g. marker components like struct Frozen {}
+	template<typename T>
+	concept EmptyComponent = std::is_empty_v<T>;
+
+	// Bytes of a component in pools, snapshots and deltas, 0 for an EmptyComponent
+	template<typename T>
+	constexpr size_t ComponentDataSize = EmptyComponent<T> ? 0 : sizeof(T);
+
+	// Pool of an EmptyComponent: same interface as Pool<T>, but only the packed entity ids and
+	// the sparse index are stored. Every component of the type is the same shared instance,
+	// passed to views and returned by Get(), so adding and removing never moves any data.
+	template <EmptyComponent T>
+	class Pool<T> final : public IPool
+	{
+	public:
+		/**
+		 * @brief Construct a new Pool object.
+		 *
+		 * @param pageSize Number of entities per sparse page, must be a power of two.
+		 * @param allocator Allocator providing the sparse pages.
+		 * @param resource Memory resource of the packed entity ids.
+		 */
+		explicit Pool(u32 pageSize = PAGE_SIZE, PageAllocator& allocator = PageAllocator::GetDefault(),
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: m_packed(resource), m_sparse(pageSize, allocator)
+		{
+			m_packed.reserve(DEFAULT_CAPACITY);
+		}
+
+		/**
+		 * @brief Destroy the Pool object.
+		 */
+		virtual ~Pool() = default;
+
+		bool IsEmpty() const { return m_packed.empty(); }
+		int GetSize() const { return (int)m_packed.size(); }
+		void Reserve(size_t capacity) { m_packed.reserve(capacity); }
+		void SetPageSize(u32 pageSize) { m_sparse.SetPageSize(pageSize); }
+		void ShrinkToFit() override { m_sparse.ShrinkToFit(); }
+		const SparseIndex& GetSparse() const { return m_sparse; }
+
+		void Clear() override
+		{
+			Touch();
+			if (m_changeTracker)
+				m_changeTracker->OnCleared(m_packed);
+
+			m_packed.clear();
+			m_sparse.Clear();
+
+			if (m_owningGroup)
+				m_owningGroup->OnPoolCleared();
+		}
+
+		bool Has(EntityID entityId) const
+		{
+			return m_sparse.Get(GetEntityIndex(entityId)) != u32_invalid_id;
+		}
+
+		bool MarkChanged(EntityID entityId)
+		{
+			const u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			assert(packedIndex != u32_invalid_id && "Entity does not have the component");
+			if (packedIndex == u32_invalid_id)
+				return false;
+
+			Touch();
+			if (m_changeTracker)
+				m_changeTracker->OnChanged(packedIndex);
+			return true;
+		}
+
+		/**
+		 * @brief Add the component to an entity, only its id is stored.
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void Add(EntityID entityId, T = {})
+		{
+			Touch();
+			m_packed.push_back(entityId);
+			m_sparse.Set(GetEntityIndex(entityId), (u32)m_packed.size() - 1);
+
+			if (m_changeTracker)
+				m_changeTracker->OnAdded();
+
+			if (m_owningGroup)
+				m_owningGroup->OnComponentAdded(entityId);
+		}
+
+		/**
+		 * @brief Add the component to an entity, or stamp it as changed if it already has it.
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void Set(EntityID entityId, T = {})
+		{
+			Touch();
+			u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			if (packedIndex != u32_invalid_id)
+			{
+				if (m_changeTracker)
+					m_changeTracker->OnChanged(packedIndex);
+			}
+			else
+				Add(entityId);
+		}
+
+		/**
+		 * @brief Replace the content of the pool with the given entities.
+		 *
+		 * @param entities Full entity ids.
+		 */
+		void Assign(std::span<const EntityID> entities, const T* = nullptr)
+		{
+			Clear();
+
+			m_packed.assign(entities.begin(), entities.end());
+			for (u32 i = 0; i < (u32)m_packed.size(); ++i)
+			{
+				m_sparse.Set(GetEntityIndex(m_packed[i]), i);
+
+				if (m_changeTracker)
+					m_changeTracker->OnAdded();
+
+				if (m_owningGroup)
+					m_owningGroup->OnComponentAdded(m_packed[i]);
+			}
+		}
+
+		/**
+		 * @brief Remove the component of an entity (swap-and-pop of its id).
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void Remove(EntityID entityId)
+		{
+			if (!Has(entityId))
+				return;
+
+			Touch();
+			if (m_owningGroup)
+				m_owningGroup->OnComponentRemoving(entityId);
+
+			u32 index = GetEntityIndex(entityId);
+
+			u32 indexToRemove = m_sparse.Get(index);
+			u32 indexLast = (u32)m_packed.size() - 1;
+
+			if (m_changeTracker)
+				m_changeTracker->OnRemoved(entityId, indexToRemove);
+
+			if (indexToRemove != indexLast)
+			{
+				u64 lastEntityId = m_packed[indexLast];
+				m_packed[indexToRemove] = lastEntityId;
+				m_sparse.Set(GetEntityIndex(lastEntityId), indexToRemove);
+			}
+
+			m_packed.pop_back();
+			m_sparse.Reset(index);
+		}
+
+		void RemoveEntityFromPool(EntityID entityId) override
+		{
+			Remove(entityId);
+		}
+
+		void RemoveEntitiesFromPool(std::span<const EntityID> entityIds) override
+		{
+			if (m_owningGroup)
+				m_owningGroup->OnComponentsRemoving(entityIds);
+
+			RemovePacked(entityIds, m_packed, m_sparse, [](u32, u32) {});
+		}
+
+		int GetPackedIndex(EntityID entityId) const override
+		{
+			u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			return packedIndex == u32_invalid_id ? -1 : (int)packedIndex;
+		}
+
+		void SwapPacked(int a, int b) override
+		{
+			if (a == b)
+				return;
+
+			Touch();
+			std::swap(m_packed[a], m_packed[b]);
+
+			if (m_changeTracker)
+				m_changeTracker->OnSwapped((u32)a, (u32)b);
+
+			m_sparse.Set(GetEntityIndex(m_packed[a]), (u32)a);
+			m_sparse.Set(GetEntityIndex(m_packed[b]), (u32)b);
+		}
+
+		/**
+		 * @brief Get the shared instance of the component, no lookup needed.
+		 *
+		 * @return T& The shared instance.
+		 */
+		T& Get(EntityID) { return s_instances[0]; }
+		const T& Get(EntityID) const { return s_instances[0]; }
+		T& operator[](unsigned int) { return s_instances[0]; }
+		const T& operator[](unsigned int) const { return s_instances[0]; }
+
+		/**
+		 * @brief Get count shared instances, for the batches of ForEachChunk().
+		 *
+		 * @param count Number of instances, at most CHUNK_BATCH_SIZE.
+		 * @return std::span<T> The shared instances.
+		 */
+		static std::span<T> GetInstances(size_t count)
+		{
+			assert(count <= CHUNK_BATCH_SIZE && "At most CHUNK_BATCH_SIZE shared instances");
+			return std::span<T>(s_instances, count);
+		}
+
+		const std::pmr::vector<EntityID>& GetEntities() const override { return m_packed; }
+
+		ResourcePtr<IPool> CreateEmpty(PageAllocator& allocator, std::pmr::memory_resource* resource) const override
+		{
+			return MakeResourceUnique<Pool>(resource, m_sparse.GetPageSize(), allocator, resource);
+		}
+
+		void GetStats(PoolStats& stats) const override
+		{
+			stats.name = GetTypeName<T>();
+			stats.size = m_packed.size();
+			stats.capacity = m_packed.capacity();
+			stats.packedBytes = m_packed.capacity() * sizeof(EntityID);
+			stats.sparsePages = m_sparse.GetAllocatedPageCount();
+			stats.sparseBytes = stats.sparsePages * m_sparse.GetPageSize() * sizeof(u32);
+		}
+
+	protected:
+		void CopyData(const IPool& source) override
+		{
+			const Pool& other = static_cast<const Pool&>(source);
+			m_packed = other.m_packed;
+			m_sparse.CopyFrom(other.m_sparse);
+		}
+
+	private:
+		static inline T s_instances[CHUNK_BATCH_SIZE] = {};
+
+		std::pmr::vector<EntityID> m_packed; // Who (Packed index: Packed index -> EntityID)
+		SparseIndex m_sparse; // Where (Paging sparse index: Entity index -> Packed index, u32_invalid_id if not present)
+	};
+}
@@ -25,6 +25,8 @@ SOFTWARE.
 #pragma once
 
 #include "Common.h"
+#include "SoA.h"
+#include "Name.h"
 #include <string>
 #include <utility>
 
@@ -105,9 +107,9 @@ namespace ECS
 		 * The caller must ensure the component exists.
 		 *
 		 * @tparam T Component type to retrieve.
-		 * @return T& Reference to the component.
+		 * @return ComponentRef<T> Reference to the component (SoARef<T> for SoA components).
 		 */
-		template<typename T> T& GetComponent() const;
+		template<typename T> ComponentRef<T> GetComponent() const;
 
 		Entity& operator=(const Entity& e) = default;
 		bool operator==(const Entity& e) const
@@ -131,35 +133,35 @@ namespace ECS
 		/**
 		 * @brief Assign a tag to this entity.
 		 *	Wrapper around Registry::TagEntity.
-		 * @param tag Tag string.
+		 * @param tag Tag name.
 		 */
-		void Tag(const std::string& tag);
+		void Tag(Name tag);
 
 		/**
 		 * @brief Check whether this entity has a given tag.
 		 *	Wrapper around Registry::EntityHasTag.
-		 * @param tag Tag string to query.
+		 * @param tag Tag name to query.
 		 * @return true If the entity has the tag.
 		 * @return false Otherwise.
 		 */
-		bool HasTag(const std::string& tag) const;
+		bool HasTag(Name tag) const;
 
 		// Manage entity groups
 		/**
 		 * @brief Add this entity to a named group.
 		 *	Wrapper around Registry::GroupEntity.
-		 * @param groupName Group name string.
+		 * @param groupName Group name.
 		 */
-		void Group(const std::string& groupName);
+		void Group(Name groupName);
 
 		/**
 		 * @brief Check whether this entity belongs to a named group.
 		 *	Wrapper around Registry::EntityBelongsToGroup.
-		 * @param groupName Group name string to query.
+		 * @param groupName Group name to query.
 		 * @return true If the entity belongs to the group.
 		 * @return false Otherwise.
 		 */
-		bool BelongsToGroup(const std::string& groupName) const;
+		bool BelongsToGroup(Name groupName) const;
 
 		Registry* registry = nullptr;
 
@@ -23,7 +23,7 @@ namespace ECS
     }
 
     template<typename T>
-    T& Entity::GetComponent() const
+    ComponentRef<T> Entity::GetComponent() const
     {
         return registry->template GetComponent<T>(*this);
     }
@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "Registry.h"
+
+namespace ECS
+{
+	std::unique_ptr<Registry> Registry::Clone() const
+	{
+		auto clone = std::make_unique<Registry>(m_storageMode, m_memoryResource);
+		clone->m_threadPool = m_threadPool;
+		clone->SetVersionOverflow(m_versionOverflow, m_maxEntityVersion);
+		clone->RestoreFrom(*this);
+		return clone;
+	}
+
+	u32 Registry::RestoreFrom(const Registry& other)
+	{
+		assert(&other != this && "A registry can not be restored from itself");
+		assert(!m_archetypes && !other.m_archetypes && "RestoreFrom() needs StorageMode::SparseSet");
+		assert(m_owningGroups.empty() && other.m_owningGroups.empty() && "RestoreFrom() does not support owning groups");
+
+		// Component ids: the same for the types both registries use, a type only one of them
+		// uses must have an id the other never handed out
+		const size_t typeCount = std::max(m_componentIds.size(), other.m_componentIds.size());
+		m_componentIds.resize(typeCount, u32_invalid_id);
+		for (size_t typeId = 0; typeId < typeCount; ++typeId)
+		{
+			const u32 otherId = typeId < other.m_componentIds.size() ? other.m_componentIds[typeId] : u32_invalid_id;
+			if (m_componentIds[typeId] == u32_invalid_id)
+			{
+				assert((otherId == u32_invalid_id || otherId >= m_componentCount) && "Registries do not share their component ids");
+				m_componentIds[typeId] = otherId;
+			}
+			else
+				assert((otherId == u32_invalid_id ? m_componentIds[typeId] >= other.m_componentCount : otherId == m_componentIds[typeId]) && "Registries do not share their component ids");
+		}
+		m_componentCount = std::max(m_componentCount, other.m_componentCount);
+
+		// Pools, skipping the ones unchanged since the last restore
+		u32 copiedPools = 0;
+		m_componentPools.resize(std::max(m_componentPools.size(), other.m_componentPools.size()));
+		m_pendingPoolRemovals.resize(m_componentPools.size());
+		for (size_t componentId = 0; componentId < m_componentPools.size(); ++componentId)
+		{
+			ResourcePtr<IPool>& pool = m_componentPools[componentId];
+			const IPool* source = componentId < other.m_componentPools.size() ? other.m_componentPools[componentId].get() : nullptr;
+			if (!source)
+			{
+				if (pool && !pool->GetEntities().empty())
+					pool->Clear();
+				continue;
+			}
+
+			if (!pool)
+				pool = source->CreateEmpty(*m_pageAllocator, m_memoryResource);
+			if (source->GetChangeTracker())
+				pool->EnableChangeTracking(m_currentTick);
+
+			if (pool->CopyFrom(*source))
+				copiedPools++;
+		}
+
+		// Entities
+		auto copyEntities = [this](auto& to, const auto& from) {
+			to.clear();
+			for (Entity e : from)
+				to.emplace_back(e.GetId(), this);
+			};
+
+		m_currentTick = other.m_currentTick;
+		m_numEntities = other.m_numEntities;
+		m_entitySlots = other.m_entitySlots;
+		m_freeHead = other.m_freeHead;
+		m_freeCount = other.m_freeCount;
+		m_entityComponentSignatures = other.m_entityComponentSignatures;
+		copyEntities(m_entitiesToBeAdded, other.m_entitiesToBeAdded);
+		copyEntities(m_entitiesToBeKilled, other.m_entitiesToBeKilled);
+		m_signatureChanges = other.m_signatureChanges;
+		m_systemSyncPending = other.m_systemSyncPending;
+
+		m_entityLogEnabled = other.m_entityLogEnabled;
+		m_createdEntityLog = other.m_createdEntityLog;
+		m_killedEntityLog = other.m_killedEntityLog;
+
+		// Tags and groups
+		m_entityToTag = other.m_entityToTag;
+		m_tagToEntity = other.m_tagToEntity;
+		m_names = other.m_names;
+
+		m_groups.resize(other.m_groups.size());
+		for (size_t i = 0; i < m_groups.size(); ++i)
+		{
+			if (!m_groups[i])
+				m_groups[i] = MakeResourceUnique<GroupData>(m_memoryResource, *m_pageAllocator, m_memoryResource);
+			copyEntities(m_groups[i]->entities, other.m_groups[i]->entities);
+			m_groups[i]->sparse.CopyFrom(other.m_groups[i]->sparse);
+		}
+		m_groupLookup = other.m_groupLookup;
+
+		// Systems and queries without a counterpart are rebuilt from the signatures (alive entities only)
+		auto forEachMatchingEntity = [this](const Signature& signature, auto&& func) {
+			for (u32 index = 0; index < (u32)m_numEntities; ++index)
+			{
+				if (IsSlotAlive(index) && m_entityComponentSignatures[index].Contains(signature))
+					func(m_entitySlots[index]);
+			}
+			};
+
+		for (auto& [type, system] : m_systems)
+		{
+			auto counterpart = other.m_systems.find(type);
+			if (counterpart != other.m_systems.end())
+			{
+				copyEntities(system->m_entities, counterpart->second->m_entities);
+				system->m_entityToIndex = counterpart->second->m_entityToIndex;
+				continue;
+			}
+
+			system->m_entities.clear();
+			std::fill(system->m_entityToIndex.begin(), system->m_entityToIndex.end(), -1);
+			forEachMatchingEntity(system->GetComponentSignature(), [this, &system](EntityID entityId) {
+				const u32 index = GetEntityIndex(entityId);
+				if (index >= system->m_entityToIndex.size())
+					system->m_entityToIndex.resize(index + 1, -1);
+
+				system->m_entityToIndex[index] = (int)system->m_entities.size();
+				system->m_entities.emplace_back(entityId, this);
+				});
+		}
+
+		for (const auto& query : m_queries)
+		{
+			auto counterpart = std::find_if(other.m_queries.begin(), other.m_queries.end(),
+				[&query](const auto& otherQuery) { return otherQuery->GetSignature() == query->GetSignature(); });
+			if (counterpart != other.m_queries.end())
+			{
+				query->CopyFrom(**counterpart);
+				continue;
+			}
+
+			query->Clear();
+			forEachMatchingEntity(query->GetSignature(), [&query](EntityID entityId) { query->Add(entityId); });
+		}
+
+		// The events of the other registry are not replayed
+		for (ComponentObservers& observers : m_observers)
+		{
+			for (std::vector<EntityID>& pending : observers.pending)
+				pending.clear();
+		}
+
+		return copiedPools;
+	}
+}
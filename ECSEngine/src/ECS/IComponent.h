@@ -26,11 +26,13 @@ SOFTWARE.
 
 #include "../PrimitiveTypes.h"
 
+#include <atomic>
+
 namespace ECS
 {
 	struct IComponent
 	{
 	protected:
-		static u64 nextId;
+		static std::atomic<u64> nextId; // Atomic: ids can be first requested from worker threads
 	};
 }
\ No newline at end of file
@@ -25,9 +25,18 @@ SOFTWARE.
 #pragma once
 
 #include "Common.h"
+#include "ChangeTracker.h"
+#include "SparseIndex.h"
+#include "Profiler.h"
+#include "ResourcePtr.h"
+
+#include <atomic>
 
 namespace ECS
 {
+	class OwningGroup;
+	class PageAllocator;
+
 	// A Pool is just a contiguous data of objects of type T
 	class IPool
 	{
@@ -44,9 +53,250 @@ namespace ECS
 		 */
 		virtual void RemoveEntityFromPool(EntityID entityId) = 0;
 
+		/**
+		 * @brief Remove the data associated with several entities in one call.
+		 *	Used by the Registry to process all the kills of a frame for this pool at once.
+		 * @param entityIds Full entity ids.
+		 */
+		virtual void RemoveEntitiesFromPool(std::span<const EntityID> entityIds) = 0;
+
 		/**
 		 * @brief Clear the pool of all data.
 		 */
 		virtual void Clear() = 0;
+
+		/**
+		 * @brief Give the spare sparse page of the pool back to its page allocator.
+		 */
+		virtual void ShrinkToFit() = 0;
+
+		/**
+		 * @brief Get the list of entity ids that correspond to the packed data.
+		 *
+		 * @return const std::pmr::vector<EntityID>& Reference to the packed entity id list.
+		 */
+		virtual const std::pmr::vector<EntityID>& GetEntities() const = 0;
+
+		/**
+		 * @brief Get the packed index of an entity's component.
+		 *
+		 * @param entityId Full entity id.
+		 * @return int Packed index, -1 if the entity has no component in this pool.
+		 */
+		virtual int GetPackedIndex(EntityID entityId) const = 0;
+
+		/**
+		 * @brief Swap two packed slots (data and entity) and fix up the sparse index.
+		 *
+		 * @param a First packed index.
+		 * @param b Second packed index.
+		 */
+		virtual void SwapPacked(int a, int b) = 0;
+
+		/**
+		 * @brief Reorder the packed slots in place, following the cycles of a permutation.
+		 *	At most one SwapPacked() per slot.
+		 * @param order [new packed index] old packed index, a permutation of the pool size. Consumed.
+		 */
+		void Permute(std::span<u32> order)
+		{
+			assert(order.size() == GetEntities().size() && "The permutation must cover the whole pool");
+
+			for (u32 position = 0; position < (u32)order.size(); ++position)
+			{
+				u32 current = position;
+				u32 next = order[current];
+				while (next != position)
+				{
+					SwapPacked((int)current, (int)next);
+					order[current] = current;
+					current = next;
+					next = order[current];
+				}
+				order[current] = current;
+			}
+		}
+
+		/**
+		 * @brief Create an empty pool of the same component type, with the same sparse page size.
+		 *
+		 * @param allocator Allocator providing the sparse pages of the new pool.
+		 * @param resource Memory resource of the packed arrays of the new pool.
+		 * @return ResourcePtr<IPool> The new pool, allocated from resource.
+		 */
+		virtual ResourcePtr<IPool> CreateEmpty(PageAllocator& allocator, std::pmr::memory_resource* resource) const = 0;
+
+		/**
+		 * @brief Fill the memory usage of the pool, see Registry::GetPoolStats().
+		 *
+		 * @param stats Stats to fill, except the component id.
+		 */
+		virtual void GetStats(PoolStats& stats) const = 0;
+
+		/**
+		 * @brief Make the pool a copy of another pool of the same component type, reusing the allocations.
+		 *
+		 * Copy-on-write: nothing is copied when this pool already is a copy of the source and
+		 * neither of them was touched (see Touch()) since. The change ticks are copied when
+		 * both pools track changes. The pools must not be owned by a group.
+		 *
+		 * @param source Pool of the same component type.
+		 * @return true If the data was copied.
+		 * @return false If the pool was already up to date.
+		 */
+		bool CopyFrom(const IPool& source)
+		{
+			assert(!m_owningGroup && !source.m_owningGroup && "Pools owned by a group can not be copied");
+
+			source.Seal();
+			Seal();
+			if (m_copiedUid == source.m_uid && m_copiedGeneration == source.m_generation && m_generationAfterCopy == m_generation)
+				return false;
+
+			CopyData(source);
+			if (m_changeTracker)
+				m_changeTracker->CopyFrom(source.m_changeTracker.get(), GetEntities().size());
+
+			m_copiedUid = source.m_uid;
+			m_copiedGeneration = source.m_generation;
+			m_generationAfterCopy = ++m_generation;
+			return true;
+		}
+
+		/**
+		 * @brief Flag the pool as modified since it was last copied, see CopyFrom().
+		 *	Called by every mutable accessor of the pools, the const ones only read (see
+		 *	View<const T>). Only the first call after a copy writes, so it is cheap in loops
+		 *	and safe from the workers of a parallel view.
+		 */
+		void Touch()
+		{
+			if (!m_touched.load(std::memory_order_relaxed))
+				m_touched.store(true, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Get the owning group this pool belongs to.
+		 *
+		 * @return OwningGroup* The owning group, nullptr if none.
+		 */
+		OwningGroup* GetOwningGroup() const { return m_owningGroup; }
+
+		/**
+		 * @brief Set the owning group this pool belongs to.
+		 *	Used by OwningGroup itself, a pool can only be owned by a single group.
+		 * @param group The owning group, nullptr to release the pool.
+		 */
+		void SetOwningGroup(OwningGroup* group) { m_owningGroup = group; }
+
+		/**
+		 * @brief Start recording change ticks (see ChangeTracker). No-op if already enabled.
+		 *
+		 * @param currentTick The registry tick, must outlive the pool.
+		 */
+		void EnableChangeTracking(const u32& currentTick)
+		{
+			if (!m_changeTracker)
+			{
+				std::pmr::memory_resource* resource = GetEntities().get_allocator().resource();
+				m_changeTracker = MakeResourceUnique<ChangeTracker>(resource, currentTick, GetEntities().size(), resource);
+				Touch();
+			}
+		}
+
+		/**
+		 * @brief Get the change ticks of the pool.
+		 *
+		 * @return ChangeTracker* The tracker, nullptr if change tracking is not enabled.
+		 */
+		ChangeTracker* GetChangeTracker() const { return m_changeTracker.get(); }
+
+	protected:
+		// Copy the packed arrays and the sparse index of a pool of the same type, see CopyFrom()
+		virtual void CopyData(const IPool& source) = 0;
+
+		// Batched swap-and-pop of RemoveEntitiesFromPool(), shared by the pools: the removed entities are
+		// tombstoned, then each hole below the new size is filled once with a kept entity from the tail.
+		// move(from, to) moves the component data, the caller truncates it to the returned size.
+		template<typename Move>
+		size_t RemovePacked(std::span<const EntityID> entityIds, std::pmr::vector<EntityID>& packed, SparseIndex& sparse, Move&& move)
+		{
+			constexpr EntityID TOMBSTONE = u64_invalid_id;
+
+			// Exact ids only, duplicates hit the tombstone
+			size_t removedCount = 0;
+			for (EntityID entityId : entityIds)
+			{
+				const u32 packedIndex = sparse.Get(GetEntityIndex(entityId));
+				if (packedIndex == u32_invalid_id || packed[packedIndex] != entityId)
+					continue;
+
+				packed[packedIndex] = TOMBSTONE;
+				if (m_changeTracker)
+					m_changeTracker->OnRemoving(entityId);
+				++removedCount;
+			}
+
+			const size_t size = packed.size();
+			if (removedCount == 0)
+				return size;
+
+			Touch();
+			const u32 newSize = (u32)(size - removedCount);
+			u32 tail = (u32)size;
+			for (EntityID entityId : entityIds)
+			{
+				const u32 index = GetEntityIndex(entityId);
+				const u32 hole = sparse.Get(index);
+				if (hole == u32_invalid_id || packed[hole] != TOMBSTONE)
+					continue;
+
+				sparse.Reset(index);
+				if (hole >= newSize)
+					continue;
+
+				// As many kept entities past the new size as holes before it
+				do { --tail; } while (packed[tail] == TOMBSTONE);
+
+				move(tail, hole);
+				packed[hole] = packed[tail];
+				sparse.Set(GetEntityIndex(packed[hole]), hole);
+				if (m_changeTracker)
+					m_changeTracker->OnMoved(tail, hole);
+			}
+
+			packed.resize(newSize);
+			if (m_changeTracker)
+				m_changeTracker->OnTruncated(newSize);
+			return newSize;
+		}
+
+	protected:
+		OwningGroup* m_owningGroup = nullptr;
+		ResourcePtr<ChangeTracker> m_changeTracker;
+
+	private:
+		// Turn the touched flag into a new generation
+		void Seal() const
+		{
+			if (m_touched.exchange(false, std::memory_order_relaxed))
+				++m_generation;
+		}
+
+		static u64 NextUid()
+		{
+			static std::atomic<u64> nextUid = 1;
+			return nextUid.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	private:
+		// Copy-on-write state, see CopyFrom(). The generation advances with every copy into the
+		// pool and, at the next copy, if the pool was touched since the previous one
+		const u64 m_uid = NextUid();
+		mutable u64 m_generation = 0;
+		mutable std::atomic<bool> m_touched = false;
+		u64 m_copiedUid = 0; // Pool last copied from, 0 if none
+		u64 m_copiedGeneration = 0; // Its generation at that time
+		u64 m_generationAfterCopy = 0; // Generation of this pool right after that copy
 	};
 }
\ No newline at end of file
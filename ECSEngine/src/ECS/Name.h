@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "PrimitiveTypes.h"
+
+#include <string>
+#include <string_view>
+
+namespace ECS
+{
+	// Hashed name used as tag or group identifier. The FNV-1a hash is computed at compile time
+	// for constant names, e.g. `constexpr ECS::Name EnemiesGroup{ "enemies" };`.
+	// The string is only referenced: a Name must not outlive the characters it was built from.
+	class Name
+	{
+	public:
+		/**
+		 * @brief Construct a Name from a null-terminated string.
+		 *
+		 * @param str Name string.
+		 */
+		constexpr Name(const char* str) : Name(std::string_view(str)) {}
+
+		/**
+		 * @brief Construct a Name from a string view.
+		 *
+		 * @param str Name string.
+		 */
+		constexpr Name(std::string_view str) : m_string(str), m_hash(HashString(str)) {}
+
+		/**
+		 * @brief Construct a Name from a string.
+		 *
+		 * @param str Name string.
+		 */
+		Name(const std::string& str) : Name(std::string_view(str)) {}
+
+		/**
+		 * @brief Get the hash of the name. 0 is reserved for "no name".
+		 *
+		 * @return u32 The FNV-1a hash.
+		 */
+		constexpr u32 GetHash() const { return m_hash; }
+
+		/**
+		 * @brief Get the name string.
+		 *
+		 * @return std::string_view The name.
+		 */
+		constexpr std::string_view GetString() const { return m_string; }
+
+	private:
+		std::string_view m_string;
+		u32 m_hash;
+	};
+}
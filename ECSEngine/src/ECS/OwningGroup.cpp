@@ -0,0 +1,90 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "OwningGroup.h"
+
+namespace ECS
+{
+	OwningGroup::OwningGroup(std::vector<IPool*> pools) : m_pools(std::move(pools))
+	{
+		assert(m_pools.size() >= 2 && "An owning group needs at least two component types");
+
+		for (IPool* pool : m_pools)
+		{
+			assert(!pool->GetOwningGroup() && "A pool can only be owned by a single group");
+			pool->SetOwningGroup(this);
+		}
+
+		// Pack the entities that already have all the components.
+		// Copy the ids as the swaps below reorder the packed arrays.
+		std::vector<EntityID> candidates(m_pools[0]->GetEntities().begin(), m_pools[0]->GetEntities().end());
+		for (EntityID entityId : candidates)
+			OnComponentAdded(entityId);
+	}
+
+	OwningGroup::~OwningGroup()
+	{
+		for (IPool* pool : m_pools)
+			pool->SetOwningGroup(nullptr);
+	}
+
+	void OwningGroup::OnComponentAdded(EntityID entityId)
+	{
+		// Missing at least one component (-1) or already in the group
+		for (IPool* pool : m_pools)
+		{
+			int packedIndex = pool->GetPackedIndex(entityId);
+			if (packedIndex < (int)m_size)
+				return;
+		}
+
+		for (IPool* pool : m_pools)
+			pool->SwapPacked(pool->GetPackedIndex(entityId), (int)m_size);
+
+		++m_size;
+	}
+
+	void OwningGroup::OnComponentsRemoving(std::span<const EntityID> entityIds)
+	{
+		if (m_size == 0)
+			return;
+
+		for (EntityID entityId : entityIds)
+			OnComponentRemoving(entityId);
+	}
+
+	void OwningGroup::OnComponentRemoving(EntityID entityId)
+	{
+		// Every owned pool agrees on the group range, checking one is enough
+		int packedIndex = m_pools[0]->GetPackedIndex(entityId);
+		if (packedIndex < 0 || packedIndex >= (int)m_size)
+			return;
+
+		--m_size;
+
+		for (IPool* pool : m_pools)
+			pool->SwapPacked(pool->GetPackedIndex(entityId), (int)m_size);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+#include "IPool.h"
+
+namespace ECS
+{
+	// An owning group keeps the entities that have ALL of its component types packed in the
+	// first GetSize() slots of every owned pool, in the same order.
+	// Iterating the group is a linear walk over parallel arrays, without any sparse lookup.
+	// A pool can be owned by a single group at a time.
+	class OwningGroup
+	{
+	public:
+		/**
+		 * @brief Construct a new OwningGroup over the given pools.
+		 *
+		 * Takes ownership of the pools and packs the entities that already match.
+		 *
+		 * @param pools The pools to own (one per component type).
+		 */
+		explicit OwningGroup(std::vector<IPool*> pools);
+
+		/**
+		 * @brief Release the owned pools.
+		 */
+		~OwningGroup();
+
+		/**
+		 * @brief Called by an owned pool right after a component was added for an entity.
+		 *	Moves the entity into the group range if it now has all the owned components.
+		 * @param entityId Full entity id.
+		 */
+		void OnComponentAdded(EntityID entityId);
+
+		/**
+		 * @brief Called by an owned pool right before a component is removed for an entity.
+		 *	Moves the entity out of the group range if it was part of the group.
+		 * @param entityId Full entity id.
+		 */
+		void OnComponentRemoving(EntityID entityId);
+
+		/**
+		 * @brief Called by an owned pool right before a batch of components is removed.
+		 *	Moves the entities of the group out of its range, the others are skipped.
+		 * @param entityIds Full entity ids.
+		 */
+		void OnComponentsRemoving(std::span<const EntityID> entityIds);
+
+		/**
+		 * @brief Called by an owned pool when it is cleared. Empties the group.
+		 */
+		void OnPoolCleared() { m_size = 0; }
+
+		/**
+		 * @brief Get the number of entities in the group.
+		 *	They occupy the packed indices [0, GetSize()) of every owned pool.
+		 * @return size_t Number of entities in the group.
+		 */
+		size_t GetSize() const { return m_size; }
+
+		/**
+		 * @brief Get the pools owned by this group.
+		 *
+		 * @return const std::vector<IPool*>& The owned pools.
+		 */
+		const std::vector<IPool*>& GetPools() const { return m_pools; }
+
+	private:
+		std::vector<IPool*> m_pools;
+		size_t m_size = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "PageAllocator.h"
+
+#include <cstring>
+
+namespace ECS
+{
+	PageAllocator::~PageAllocator()
+	{
+		Trim();
+	}
+
+	PageAllocator& PageAllocator::GetDefault()
+	{
+		// Never destroyed: pools of static registries may still give pages back at exit
+		static PageAllocator* allocator = new PageAllocator();
+		return *allocator;
+	}
+
+	u32* PageAllocator::Allocate(u32 entryCount)
+	{
+		u32* page = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (FreeList& freeList : m_freeLists)
+			{
+				if (freeList.entryCount == entryCount && !freeList.pages.empty())
+				{
+					page = freeList.pages.back();
+					freeList.pages.pop_back();
+					break;
+				}
+			}
+		}
+
+		if (!page)
+			page = static_cast<u32*>(m_resource->allocate(entryCount * sizeof(u32), alignof(u32)));
+
+		// All bits set is u32_invalid_id
+		std::memset(page, 0xFF, entryCount * sizeof(u32));
+		return page;
+	}
+
+	void PageAllocator::Free(u32* page, u32 entryCount)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (FreeList& freeList : m_freeLists)
+		{
+			if (freeList.entryCount == entryCount)
+			{
+				freeList.pages.push_back(page);
+				return;
+			}
+		}
+
+		m_freeLists.push_back({ entryCount, std::pmr::vector<u32*>({ page }, m_resource) });
+	}
+
+	void PageAllocator::Trim(size_t keepPages)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (FreeList& freeList : m_freeLists)
+		{
+			while (freeList.pages.size() > keepPages)
+			{
+				m_resource->deallocate(freeList.pages.back(), freeList.entryCount * sizeof(u32), alignof(u32));
+				freeList.pages.pop_back();
+			}
+		}
+		std::erase_if(m_freeLists, [](const FreeList& freeList) { return freeList.pages.empty(); });
+	}
+
+	size_t PageAllocator::GetCachedPageCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		size_t count = 0;
+		for (const FreeList& freeList : m_freeLists)
+			count += freeList.pages.size();
+		return count;
+	}
+}
\ No newline at end of file
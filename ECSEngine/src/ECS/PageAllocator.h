@@ -0,0 +1,113 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <memory_resource>
+#include <mutex>
+
+namespace ECS
+{
+	// Allocates the sparse pages of the pools and recycles the freed ones.
+	// Pages are cached per size, so a pool releasing an empty page and another pool
+	// (or the same one) needing a page later does not go back to the heap.
+	// Thread-safe, a single allocator can be shared by pools of different registries.
+	class PageAllocator
+	{
+	public:
+		/**
+		 * @brief Construct a new PageAllocator object.
+		 *
+		 * @param resource Memory resource the pages are allocated from.
+		 */
+		explicit PageAllocator(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : m_resource(resource) {}
+
+		/**
+		 * @brief Destroy the PageAllocator object and free the cached pages.
+		 *	Pages still in use must have been freed beforehand.
+		 */
+		~PageAllocator();
+
+		PageAllocator(const PageAllocator&) = delete;
+		PageAllocator& operator=(const PageAllocator&) = delete;
+
+		/**
+		 * @brief Get the allocator shared by default by every pool.
+		 *
+		 * @return PageAllocator& The default allocator.
+		 */
+		static PageAllocator& GetDefault();
+
+		/**
+		 * @brief Allocate a page, every entry set to u32_invalid_id.
+		 *
+		 * @param entryCount Number of u32 entries in the page.
+		 * @return u32* The page.
+		 */
+		u32* Allocate(u32 entryCount);
+
+		/**
+		 * @brief Give a page back to the allocator, it is kept for reuse.
+		 *
+		 * @param page The page, allocated with the same entryCount.
+		 * @param entryCount Number of u32 entries in the page.
+		 */
+		void Free(u32* page, u32 entryCount);
+
+		/**
+		 * @brief Free the cached pages, the memory goes back to the memory resource.
+		 *
+		 * @param keepPages Number of pages to keep cached for each page size.
+		 */
+		void Trim(size_t keepPages = 0);
+
+		/**
+		 * @brief Get the number of pages currently cached for reuse.
+		 *
+		 * @return size_t Number of cached pages, all sizes included.
+		 */
+		size_t GetCachedPageCount() const;
+
+		/**
+		 * @brief Get the memory resource the pages are allocated from.
+		 *
+		 * @return std::pmr::memory_resource* The memory resource.
+		 */
+		std::pmr::memory_resource* GetResource() const { return m_resource; }
+
+	private:
+		struct FreeList
+		{
+			u32 entryCount;
+			std::pmr::vector<u32*> pages;
+		};
+
+		std::pmr::memory_resource* m_resource;
+		mutable std::mutex m_mutex;
+		std::pmr::vector<FreeList> m_freeLists{ m_resource }; // One per page size (few different sizes in practice)
+	};
+}
\ No newline at end of file
@@ -26,37 +26,41 @@ SOFTWARE.
 
 #include "Common.h"
 #include "IPool.h"
+#include "SparseIndex.h"
+#include "AlignedAllocator.h"
+#include "OwningGroup.h"
+#include "Component.h"
+
+#include <cstring>
 
 namespace ECS
 {
 	template <typename T>
-	class Pool : public IPool
+	class Pool final : public IPool
 	{
 	public:
 		/**
 		 * @brief Construct a new Pool object.
 		 *
-		 * Initializes internal storage for packed/sparse arrays.
+		 * Initializes internal storage for packed arrays. Sparse pages are allocated
+		 * on demand from the allocator.
+		 *
+		 * @param pageSize Number of entities per sparse page, must be a power of two.
+		 * @param allocator Allocator providing the sparse pages.
+		 * @param resource Memory resource of the packed arrays.
 		 */
-		Pool()
+		explicit Pool(u32 pageSize = PAGE_SIZE, PageAllocator& allocator = PageAllocator::GetDefault(),
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: m_data(AlignedAllocator<T, CACHE_LINE_SIZE>(resource)), m_packed(resource), m_sparse(pageSize, allocator)
 		{
 			m_data.reserve(DEFAULT_CAPACITY);
 			m_packed.reserve(DEFAULT_CAPACITY);
-
-			m_sparse.resize(MAX_ENTITIES / PAGE_SIZE + 1, nullptr);
 		}
 
 		/**
 		 * @brief Destroy the Pool object.
 		 */
-		virtual ~Pool()
-		{
-			for (int* page : m_sparse)
-			{
-				if (page)
-					delete[] page;
-			}
-		}
+		virtual ~Pool() = default;
 
 		/**
 		 * @brief Check whether the pool contains any components.
@@ -73,23 +77,52 @@ namespace ECS
 		 */
 		int GetSize() const { return (int)m_data.size(); }
 
+		/**
+		 * @brief Reserve storage for at least capacity components.
+		 *
+		 * @param capacity Number of components to reserve storage for.
+		 */
+		void Reserve(size_t capacity)
+		{
+			m_data.reserve(capacity);
+			m_packed.reserve(capacity);
+		}
+
+		/**
+		 * @brief Change the number of entities per sparse page. The pool must be empty.
+		 *
+		 * @param pageSize Number of entities per sparse page, must be a power of two.
+		 */
+		void SetPageSize(u32 pageSize) { m_sparse.SetPageSize(pageSize); }
+
+		/**
+		 * @brief Give the spare sparse page back to the page allocator (IPool override).
+		 */
+		void ShrinkToFit() override { m_sparse.ShrinkToFit(); }
+
+		/**
+		 * @brief Get the sparse index of the pool.
+		 *
+		 * @return const SparseIndex& The sparse index (entity index -> packed index).
+		 */
+		const SparseIndex& GetSparse() const { return m_sparse; }
+
 		/**
 		 * @brief Remove all components from the pool.
 		 *	Clears internal packed and sparse arrays.
 		 */
 		void Clear() override
 		{
+			Touch();
+			if (m_changeTracker)
+				m_changeTracker->OnCleared(m_packed);
+
 			m_data.clear();
 			m_packed.clear();
+			m_sparse.Clear();
 
-			for (int*& page : m_sparse)
-			{
-				if (page)
-				{
-					delete[] page;
-					page = nullptr;
-				}
-			}
+			if (m_owningGroup)
+				m_owningGroup->OnPoolCleared();
 		}
 
 		/**
@@ -101,14 +134,26 @@ namespace ECS
 		 */
 		bool Has(EntityID entityId) const
 		{
-			u32 index = GetEntityIndex(entityId);
-			u32 page = index / PAGE_SIZE;
-			u32 offset = index % PAGE_SIZE;
+			return m_sparse.Get(GetEntityIndex(entityId)) != u32_invalid_id;
+		}
 
-			if (page >= m_sparse.size() || m_sparse[page] == nullptr)
+		/**
+		 * @brief Stamp the component of an entity as changed. No-op without change tracking.
+		 *
+		 * @param entityId Full entity id, must have a component in the pool.
+		 * @return false If the entity has no component in the pool, nothing is stamped.
+		 */
+		bool MarkChanged(EntityID entityId)
+		{
+			const u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			assert(packedIndex != u32_invalid_id && "Entity does not have the component");
+			if (packedIndex == u32_invalid_id)
 				return false;
 
-			return m_sparse[page][offset] != -1;
+			Touch();
+			if (m_changeTracker)
+				m_changeTracker->OnChanged(packedIndex);
+			return true;
 		}
 
 		/**
@@ -119,25 +164,16 @@ namespace ECS
 		 */
 		void Add(EntityID entityId, T object)
 		{
-			u32 index = GetEntityIndex(entityId);
-			u32 page = index / PAGE_SIZE;
-			u32 offset = index % PAGE_SIZE;
-
-			if (page >= m_sparse.size())
-			{
-				assert(index < MAX_ENTITIES && "Entity index exceeds maximum allowed entities");
-				m_sparse.resize(page + 1, nullptr);
-			}
-
-			if (!m_sparse[page])
-			{
-				m_sparse[page] = new int[PAGE_SIZE]();
-				std::fill(m_sparse[page], m_sparse[page] + PAGE_SIZE, -1);
-			}
-
+			Touch();
 			m_data.push_back(std::move(object));
 			m_packed.push_back(entityId);
-			m_sparse[page][offset] = (int)m_data.size() - 1;
+			m_sparse.Set(GetEntityIndex(entityId), (u32)m_data.size() - 1);
+
+			if (m_changeTracker)
+				m_changeTracker->OnAdded();
+
+			if (m_owningGroup)
+				m_owningGroup->OnComponentAdded(entityId);
 		}
 
 		/**
@@ -150,13 +186,50 @@ namespace ECS
 		 */
 		void Set(EntityID entityId, T object)
 		{
-			u32 index = GetEntityIndex(entityId);
-			if (Has(entityId))
-				m_data[m_sparse[index / PAGE_SIZE][index % PAGE_SIZE]] = std::move(object);
+			Touch();
+			u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			if (packedIndex != u32_invalid_id)
+			{
+				m_data[packedIndex] = std::move(object);
+				if (m_changeTracker)
+					m_changeTracker->OnChanged(packedIndex);
+			}
 			else
 				Add(entityId, std::move(object));
 		}
 
+		/**
+		 * @brief Replace the content of the pool with count components, copied in bulk.
+		 *	The sparse index is rebuilt in a single pass over the entities.
+		 * @param entities Full entity ids, one per component.
+		 * @param data Components, in the same order as entities.
+		 */
+		void Assign(std::span<const EntityID> entities, const T* data)
+		{
+			Clear();
+
+			m_packed.assign(entities.begin(), entities.end());
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				m_data.resize(entities.size());
+				if (!entities.empty())
+					std::memcpy(m_data.data(), data, entities.size() * sizeof(T));
+			}
+			else
+				m_data.assign(data, data + entities.size());
+
+			for (u32 i = 0; i < (u32)m_packed.size(); ++i)
+			{
+				m_sparse.Set(GetEntityIndex(m_packed[i]), i);
+
+				if (m_changeTracker)
+					m_changeTracker->OnAdded();
+
+				if (m_owningGroup)
+					m_owningGroup->OnComponentAdded(m_packed[i]);
+			}
+		}
+
 		/**
 		 * @brief Remove the component for an entity.
 		 *
@@ -169,29 +242,35 @@ namespace ECS
 			if (!Has(entityId))
 				return;
 
+			Touch();
+
+			// Leave the owning group first so the swap-and-pop below stays outside its range
+			if (m_owningGroup)
+				m_owningGroup->OnComponentRemoving(entityId);
+
 			u32 index = GetEntityIndex(entityId);
-			u32 page = index / PAGE_SIZE;
-			u32 offset = index % PAGE_SIZE;
 
-			int indexToRemove = m_sparse[page][offset];
-			int indexLast = (int)m_data.size() - 1;
+			u32 indexToRemove = m_sparse.Get(index);
+			u32 indexLast = (u32)m_data.size() - 1;
+
+			if (m_changeTracker)
+				m_changeTracker->OnRemoved(entityId, indexToRemove);
 
 			if (indexToRemove != indexLast)
 			{
 				u64 lastEntityId = m_packed[indexLast];
-				u32 lastEntityIndex = GetEntityIndex(lastEntityId);
 
 				// We move the latest element into the new free space
 				m_data[indexToRemove] = std::move(m_data[indexLast]);
 				m_packed[indexToRemove] = lastEntityId;
 
-				// Update sparce with the moved entity
-				m_sparse[lastEntityIndex / PAGE_SIZE][lastEntityIndex % PAGE_SIZE] = indexToRemove;
+				// Update sparse with the moved entity
+				m_sparse.Set(GetEntityIndex(lastEntityId), indexToRemove);
 			}
 
 			m_data.pop_back();
 			m_packed.pop_back();
-			m_sparse[page][offset] = -1;
+			m_sparse.Reset(index); // Releases the page once it is empty
 		}
 
 		/**
@@ -204,6 +283,54 @@ namespace ECS
 			Remove(entityId);
 		}
 
+		/**
+		 * @brief Remove several entities' components from the pool (IPool override).
+		 *
+		 * @param entityIds Full entity ids.
+		 */
+		void RemoveEntitiesFromPool(std::span<const EntityID> entityIds) override
+		{
+			if (m_owningGroup)
+				m_owningGroup->OnComponentsRemoving(entityIds);
+
+			const size_t size = RemovePacked(entityIds, m_packed, m_sparse, [this](u32 from, u32 to) { m_data[to] = std::move(m_data[from]); });
+			m_data.erase(m_data.begin() + size, m_data.end());
+		}
+
+		/**
+		 * @brief Get the packed index of an entity's component (IPool override).
+		 *
+		 * @param entityId Full entity id.
+		 * @return int Packed index, -1 if the entity has no component in this pool.
+		 */
+		int GetPackedIndex(EntityID entityId) const override
+		{
+			u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			return packedIndex == u32_invalid_id ? -1 : (int)packedIndex;
+		}
+
+		/**
+		 * @brief Swap two packed slots and fix up the sparse index (IPool override).
+		 *
+		 * @param a First packed index.
+		 * @param b Second packed index.
+		 */
+		void SwapPacked(int a, int b) override
+		{
+			if (a == b)
+				return;
+
+			Touch();
+			std::swap(m_data[a], m_data[b]);
+			std::swap(m_packed[a], m_packed[b]);
+
+			if (m_changeTracker)
+				m_changeTracker->OnSwapped((u32)a, (u32)b);
+
+			m_sparse.Set(GetEntityIndex(m_packed[a]), (u32)a);
+			m_sparse.Set(GetEntityIndex(m_packed[b]), (u32)b);
+		}
+
 		/**
 		 * @brief Retrieve a reference to the component for an entity.
 		 *
@@ -214,12 +341,10 @@ namespace ECS
 		 */
 		T& Get(EntityID entityId)
 		{
-			u32 index = GetEntityIndex(entityId);
-			u32 page = index / PAGE_SIZE;
-			u32 offset = index % PAGE_SIZE;
-
-			return m_data[m_sparse[page][offset]];
+			Touch();
+			return m_data[m_sparse.Get(GetEntityIndex(entityId))];
 		}
+		const T& Get(EntityID entityId) const { return m_data[m_sparse.Get(GetEntityIndex(entityId))]; }
 
 		/**
 		 * @brief Access component data by packed index.
@@ -229,26 +354,77 @@ namespace ECS
 		 */
 		T& operator[](unsigned int index)
 		{
+			Touch();
 			return m_data[index];
 		}
+		const T& operator[](unsigned int index) const { return m_data[index]; }
 
 		/**
 		 * @brief Get direct access to the internal packed component array.
-		 *
+		 *	The mutable accessors touch the pool (see Touch()), the const ones are plain reads.
 		 * @return std::vector<T>& Reference to the packed data vector.
 		 */
-		std::vector<T>& GetData() { return m_data; }
+		std::vector<T, AlignedAllocator<T, CACHE_LINE_SIZE>>& GetData() { Touch(); return m_data; }
+		const std::vector<T, AlignedAllocator<T, CACHE_LINE_SIZE>>& GetData() const { return m_data; }
 
 		/**
 		 * @brief Get the list of entity ids that correspond to the packed data.
 		 *
-		 * @return const std::vector<u64>& Reference to the packed entity id list.
+		 * @return const std::pmr::vector<EntityID>& Reference to the packed entity id list.
+		 */
+		const std::pmr::vector<EntityID>& GetEntities() const override { return m_packed; }
+
+		/**
+		 * @brief Create an empty pool of the same type and sparse page size (IPool override).
+		 *
+		 * @param allocator Allocator providing the sparse pages.
+		 * @param resource Memory resource of the packed arrays.
+		 * @return ResourcePtr<IPool> The new pool, allocated from resource.
 		 */
-		const std::vector<EntityID>& GetEntities() const { return m_packed; }
+		ResourcePtr<IPool> CreateEmpty(PageAllocator& allocator, std::pmr::memory_resource* resource) const override
+		{
+			return MakeResourceUnique<Pool>(resource, m_sparse.GetPageSize(), allocator, resource);
+		}
+
+		/**
+		 * @brief Fill the memory usage of the pool (IPool override).
+		 *
+		 * @param stats Stats to fill, except the component id.
+		 */
+		void GetStats(PoolStats& stats) const override
+		{
+			stats.name = GetTypeName<T>();
+			stats.size = m_data.size();
+			stats.capacity = m_data.capacity();
+			stats.packedBytes = m_data.capacity() * sizeof(T) + m_packed.capacity() * sizeof(EntityID);
+			stats.sparsePages = m_sparse.GetAllocatedPageCount();
+			stats.sparseBytes = stats.sparsePages * m_sparse.GetPageSize() * sizeof(u32);
+		}
+
+	protected:
+		void CopyData(const IPool& source) override
+		{
+			const Pool& other = static_cast<const Pool&>(source);
+
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				m_data.resize(other.m_data.size());
+				if (!m_data.empty())
+					std::memcpy(m_data.data(), other.m_data.data(), m_data.size() * sizeof(T));
+			}
+			else
+				m_data = other.m_data;
+
+			m_packed = other.m_packed;
+			m_sparse.CopyFrom(other.m_sparse);
+		}
 
 	private:
-		std::vector<T> m_data; // What (Packed index: Packed index -> Component)
-		std::vector<EntityID> m_packed; // Who (Packed index: Packed index -> EntityID)
-		std::vector<int*> m_sparse; // Where (Paging sparse index: EntityID -> Packed index, -1 if not present)
+		std::vector<T, AlignedAllocator<T, CACHE_LINE_SIZE>> m_data; // What (Packed index: Packed index -> Component), cache-line aligned for ForEachChunk
+		std::pmr::vector<EntityID> m_packed; // Who (Packed index: Packed index -> EntityID)
+		SparseIndex m_sparse; // Where (Paging sparse index: Entity index -> Packed index, u32_invalid_id if not present)
 	};
-}
\ No newline at end of file
+}
+
+#include "SoAPool.h"
+#include "EmptyPool.h"
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "Profiler.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+
+namespace ECS
+{
+	namespace
+	{
+		u32 GetThreadId()
+		{
+			static std::atomic<u32> nextThreadId = 0;
+			thread_local const u32 threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+			return threadId;
+		}
+
+		void WriteJsonString(std::ostream& out, std::string_view text)
+		{
+			out << '"';
+			for (char c : text)
+			{
+				if (c == '"' || c == '\\')
+					out << '\\';
+				out << c;
+			}
+			out << '"';
+		}
+	}
+
+	Profiler::Profiler() : m_origin(std::chrono::steady_clock::now())
+	{
+		m_frames.emplace_back();
+	}
+
+	u64 Profiler::Now() const
+	{
+		return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_origin).count();
+	}
+
+	void Profiler::Record(std::string_view name, u64 start, u64 end, u32 entityCount)
+	{
+		const u32 threadId = GetThreadId();
+
+		std::lock_guard lock(m_mutex);
+		m_events.push_back({ name, start, end - start, entityCount, threadId, m_frames.back().frame });
+	}
+
+	void Profiler::NextFrame(u32 freeEntities)
+	{
+		FrameCounters& current = m_frames.back();
+		current.freeEntities = freeEntities;
+
+		FrameCounters next;
+		next.frame = current.frame + 1;
+		next.start = Now();
+		m_frames.push_back(next);
+	}
+
+	void Profiler::Clear()
+	{
+		std::lock_guard lock(m_mutex);
+		m_events.clear();
+
+		FrameCounters current;
+		current.frame = m_frames.back().frame;
+		current.start = Now();
+		m_frames.assign(1, current);
+	}
+
+	void Profiler::WriteChromeTrace(std::ostream& out) const
+	{
+		auto microseconds = [](u64 nanoseconds) { return (double)nanoseconds / 1000.0; };
+
+		// Whole microseconds plus a nanosecond fraction, never in exponent notation
+		const std::ios_base::fmtflags flags = out.flags();
+		const std::streamsize precision = out.precision();
+		out << std::fixed << std::setprecision(3);
+
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first = true;
+		auto separator = [&out, &first]() {
+			if (!first)
+				out << ',';
+			first = false;
+			out << '\n';
+			};
+
+		for (const ProfileEvent& event : m_events)
+		{
+			separator();
+			out << "{\"name\":";
+			WriteJsonString(out, event.name);
+			out << ",\"cat\":\"ecs\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+				<< ",\"ts\":" << microseconds(event.start) << ",\"dur\":" << microseconds(event.duration)
+				<< ",\"args\":{\"frame\":" << event.frame;
+			if (event.entityCount != u32_invalid_id)
+				out << ",\"entities\":" << event.entityCount;
+			out << "}}";
+		}
+
+		for (const FrameCounters& frame : m_frames)
+		{
+			separator();
+			out << "{\"name\":\"Structural changes\",\"ph\":\"C\",\"pid\":1,\"ts\":" << microseconds(frame.start)
+				<< ",\"args\":{\"created\":" << frame.entitiesCreated << ",\"killed\":" << frame.entitiesKilled
+				<< ",\"added\":" << frame.componentsAdded << ",\"removed\":" << frame.componentsRemoved << "}}";
+			separator();
+			out << "{\"name\":\"Free entities\",\"ph\":\"C\",\"pid\":1,\"ts\":" << microseconds(frame.start)
+				<< ",\"args\":{\"count\":" << frame.freeEntities << "}}";
+		}
+
+		out << "\n]}\n";
+		out.flags(flags);
+		out.precision(precision);
+	}
+
+	bool Profiler::WriteChromeTrace(const std::string& path) const
+	{
+		std::ofstream out(path, std::ios::binary);
+		if (!out)
+			return false;
+
+		WriteChromeTrace(out);
+		return (bool)out;
+	}
+}
@@ -0,0 +1,196 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Common.h"
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Registry instrumentation, set with the ECS_ENABLE_PROFILING CMake option (off by default).
+// When off the hooks compile to nothing, the Profiler of a registry then stays empty.
+#ifndef ECS_ENABLE_PROFILING
+#define ECS_ENABLE_PROFILING 0
+#endif
+
+#define ECS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ECS_PROFILE_CONCAT(a, b) ECS_PROFILE_CONCAT_IMPL(a, b)
+
+#if ECS_ENABLE_PROFILING
+// Time the enclosing scope as an event of the profiler
+#define ECS_PROFILE_SCOPE(profiler, name) ::ECS::ProfileScope ECS_PROFILE_CONCAT(ecsProfileScope, __LINE__)(profiler, name)
+// Add n to a FrameCounters field of the current frame
+#define ECS_PROFILE_COUNT(profiler, counter, n) ((profiler).GetCurrentFrame().counter += (u32)(n))
+#else
+#define ECS_PROFILE_SCOPE(profiler, name) ((void)0)
+#define ECS_PROFILE_COUNT(profiler, counter, n) ((void)0)
+#endif
+
+namespace ECS
+{
+	// A timed scope: Registry::Update() and its phases, a system, a view
+	struct ProfileEvent
+	{
+		std::string_view name; // Static string (type names, literals)
+		u64 start; // Nanoseconds since the profiler was created
+		u64 duration; // Nanoseconds
+		u32 entityCount; // Entities processed, u32_invalid_id if not relevant
+		u32 threadId; // Small id of the recording thread, 0 for the first one
+		u32 frame;
+	};
+
+	// Structural changes of a frame (from an Update() to the next one)
+	struct FrameCounters
+	{
+		u32 frame = 0;
+		u64 start = 0; // Nanoseconds since the profiler was created
+		u32 entitiesCreated = 0;
+		u32 entitiesKilled = 0;
+		u32 componentsAdded = 0;
+		u32 componentsRemoved = 0; // Through RemoveComponent(), the components of killed entities are not counted
+		u32 freeEntities = 0; // Free list length at the end of the frame
+	};
+
+	// Memory used by the pool of a component type, see Registry::GetPoolStats()
+	struct PoolStats
+	{
+		std::string_view name; // Component type name
+		u32 componentId;
+		size_t size; // Number of components
+		size_t capacity; // Number of components the packed arrays can hold
+		size_t packedBytes; // Capacity of the packed component and entity id arrays, in bytes
+		size_t sparsePages; // Allocated sparse pages
+		size_t sparseBytes;
+	};
+
+	// Events and frame counters recorded by a Registry built with ECS_ENABLE_PROFILING.
+	// Events accumulate until Clear(): export them with WriteChromeTrace() and clear every few frames.
+	class Profiler
+	{
+	public:
+		/**
+		 * @brief Construct a new Profiler object, its clock starts at 0.
+		 */
+		Profiler();
+
+		/**
+		 * @brief Get the time elapsed since the profiler was created.
+		 *
+		 * @return u64 Nanoseconds.
+		 */
+		u64 Now() const;
+
+		/**
+		 * @brief Record a timed event in the current frame. Thread-safe.
+		 *
+		 * @param name Event name, must outlive the profiler (static string).
+		 * @param start Start time, see Now().
+		 * @param end End time, see Now().
+		 * @param entityCount Entities processed, u32_invalid_id if not relevant.
+		 */
+		void Record(std::string_view name, u64 start, u64 end, u32 entityCount = u32_invalid_id);
+
+		/**
+		 * @brief Close the current frame and start the next one. Called by Registry::Update().
+		 *
+		 * @param freeEntities Free list length at the end of the frame.
+		 */
+		void NextFrame(u32 freeEntities);
+
+		/**
+		 * @brief Get the counters of the frame in progress, increased by the registry.
+		 *
+		 * @return FrameCounters& The counters.
+		 */
+		FrameCounters& GetCurrentFrame() { return m_frames.back(); }
+
+		/**
+		 * @brief Get the recorded events, oldest first. Not to be called while events are recorded.
+		 *
+		 * @return std::span<const ProfileEvent> The events.
+		 */
+		std::span<const ProfileEvent> GetEvents() const { return m_events; }
+
+		/**
+		 * @brief Get the counters of the recorded frames, the frame in progress last.
+		 *
+		 * @return std::span<const FrameCounters> The frame counters.
+		 */
+		std::span<const FrameCounters> GetFrames() const { return m_frames; }
+
+		/**
+		 * @brief Forget the recorded events and frames, the frame in progress is kept (reset).
+		 */
+		void Clear();
+
+		/**
+		 * @brief Write the events and counters in the Chrome trace event format (JSON).
+		 *
+		 * Opens in chrome://tracing and ui.perfetto.dev, and converts to a Tracy capture with
+		 * Tracy's import-chrome tool. Events are complete ("X") events with the entity count in
+		 * their args, frame counters are counter ("C") events. Times are in microseconds.
+		 *
+		 * @param out Destination stream.
+		 */
+		void WriteChromeTrace(std::ostream& out) const;
+
+		/**
+		 * @brief Write the Chrome trace to a file, see WriteChromeTrace(std::ostream&).
+		 *
+		 * @param path File path.
+		 * @return true If the file was written.
+		 * @return false On I/O error.
+		 */
+		bool WriteChromeTrace(const std::string& path) const;
+
+	private:
+		std::chrono::steady_clock::time_point m_origin;
+		std::mutex m_mutex; // Guards m_events, systems and views record from worker threads
+		std::vector<ProfileEvent> m_events;
+		std::vector<FrameCounters> m_frames; // Never empty, the frame in progress last
+	};
+
+	// RAII timing of a scope, see ECS_PROFILE_SCOPE
+	class ProfileScope
+	{
+	public:
+		ProfileScope(Profiler& profiler, std::string_view name) : m_profiler(profiler), m_name(name), m_start(profiler.Now()) {}
+		~ProfileScope() { m_profiler.Record(m_name, m_start, m_profiler.Now(), m_entityCount); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+		void SetEntityCount(u32 entityCount) { m_entityCount = entityCount; }
+
+	private:
+		Profiler& m_profiler;
+		std::string_view m_name;
+		u64 m_start;
+		u32 m_entityCount = u32_invalid_id;
+	};
+}
@@ -0,0 +1,59 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Query.h"
+
+namespace ECS
+{
+	QueryState::QueryState(const Signature& signature)
+		: m_signature(signature)
+	{
+	}
+
+	void QueryState::Add(EntityID entityId)
+	{
+		if (Contains(entityId))
+			return;
+
+		m_sparse.Set(GetEntityIndex(entityId), (u32)m_entities.size());
+		m_entities.push_back(entityId);
+	}
+
+	void QueryState::Remove(EntityID entityId)
+	{
+		if (!Contains(entityId))
+			return;
+
+		const u32 index = GetEntityIndex(entityId);
+		const u32 position = m_sparse.Get(index);
+		const EntityID last = m_entities.back();
+
+		m_entities[position] = last;
+		m_sparse.Set(GetEntityIndex(last), position);
+
+		m_entities.pop_back();
+		m_sparse.Reset(index);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+#include "Entity.h"
+#include "SparseIndex.h"
+
+namespace ECS
+{
+	class Registry;
+
+	// Dense list of the entities whose signature contains a given signature.
+	// Owned by the Registry, which keeps it up to date as components are added/removed
+	// and entities killed, so iterating it never re-tests membership.
+	class QueryState
+	{
+	public:
+		/**
+		 * @brief Construct a new QueryState object.
+		 *
+		 * @param signature The components an entity needs to match.
+		 */
+		explicit QueryState(const Signature& signature);
+
+		const Signature& GetSignature() const { return m_signature; }
+
+		/**
+		 * @brief Get the matching entities (unordered).
+		 *
+		 * @return const std::vector<EntityID>& The matching entity ids.
+		 */
+		const std::vector<EntityID>& GetEntities() const { return m_entities; }
+
+		/**
+		 * @brief Check whether an entity matches the query.
+		 *
+		 * @param entityId Full entity id.
+		 * @return true If the entity is in the query.
+		 * @return false Otherwise.
+		 */
+		bool Contains(EntityID entityId) const
+		{
+			const u32 position = m_sparse.Get(GetEntityIndex(entityId));
+			return position != u32_invalid_id && m_entities[position] == entityId;
+		}
+
+		/**
+		 * @brief Add a matching entity. Ignored if it is already in the query.
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void Add(EntityID entityId);
+
+		/**
+		 * @brief Remove an entity in O(1) (swap-and-pop). Ignored if it is not in the query.
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void Remove(EntityID entityId);
+
+		/**
+		 * @brief Remove every entity.
+		 */
+		void Clear()
+		{
+			m_entities.clear();
+			m_sparse.Clear();
+		}
+
+		/**
+		 * @brief Take the entities of a query with the same signature, reusing the allocations.
+		 *
+		 * @param other The query to copy.
+		 */
+		void CopyFrom(const QueryState& other)
+		{
+			assert(other.m_signature == m_signature && "Queries must have the same signature");
+			m_entities = other.m_entities;
+			m_sparse.CopyFrom(other.m_sparse);
+		}
+
+	private:
+		Signature m_signature;
+		std::vector<EntityID> m_entities;
+		SparseIndex m_sparse; // Entity index -> position in m_entities
+	};
+
+	// Typed handle over a QueryState, see Registry::CreateQuery()
+	template<typename... Components>
+	class Query
+	{
+	public:
+		Query(Registry& registry, QueryState& state) : m_registry(&registry), m_state(&state) {}
+
+		/**
+		 * @brief Call func(EntityID, Component&...) on every matching entity.
+		 *
+		 * Components must not be added/removed and entities not killed during the iteration.
+		 *
+		 * @param func The lambda function taking (EntityID, Component&...).
+		 */
+		template<typename Func> void Each(Func&& func) const;
+
+		const std::vector<EntityID>& GetEntities() const { return m_state->GetEntities(); }
+		size_t GetSize() const { return m_state->GetEntities().size(); }
+		bool Contains(Entity e) const { return m_state->Contains(e.GetId()); }
+
+	private:
+		Registry* m_registry;
+		QueryState* m_state;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+// Implementation of Query template methods
+// Included from Registry.h after Registry is defined
+
+namespace ECS
+{
+	template<typename... Components>
+	template<typename Func>
+	void Query<Components...>::Each(Func&& func) const
+	{
+		const std::vector<EntityID>& entities = m_state->GetEntities();
+		if (entities.empty())
+			return;
+
+		if (m_registry->m_archetypes)
+		{
+			for (EntityID entityId : entities)
+				func(entityId, m_registry->template GetComponent<Components>(Entity(entityId))...);
+			return;
+		}
+
+		// Every matching entity has all the components, the pools exist
+		auto pools = std::make_tuple(m_registry->template GetPool<Components>()...);
+		for (EntityID entityId : entities)
+			func(entityId, std::get<Pool<Components>*>(pools)->Get(entityId)...);
+	}
+}
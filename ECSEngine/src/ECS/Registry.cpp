@@ -25,6 +25,9 @@ SOFTWARE.
 #include "Registry.h"
 #include "Component.h"
 
+#include <cstdio>
+#include <cstdlib>
+
 namespace ECS
 {
 	// Entity implementation moved to Entity.h
@@ -39,41 +42,232 @@ namespace ECS
 		return m_id;
 	}
 
+	Registry::Registry(StorageMode storageMode, std::pmr::memory_resource* resource)
+		: m_memoryResource(resource), m_pageAllocator(&PageAllocator::GetDefault()), m_storageMode(storageMode)
+	{
+		// The shared page cache only serves the default resource
+		if (m_memoryResource != std::pmr::get_default_resource())
+		{
+			m_ownedPageAllocator = std::make_unique<PageAllocator>(m_memoryResource);
+			m_pageAllocator = m_ownedPageAllocator.get();
+		}
+
+		if (m_storageMode == StorageMode::Archetype)
+			m_archetypes = MakeResourceUnique<ArchetypeStorage>(m_memoryResource, m_memoryResource);
+	}
+
 	void Registry::Update()
 	{
+#if ECS_ENABLE_PROFILING
+		const u64 updateStart = m_profiler.Now();
+#endif
+
+		// Recorded structural changes first, their entities join the systems below
+		PlaybackCommandBuffers();
+
+		if (m_systemIndexDirty)
+			BuildSystemIndex();
+
+		// Live entities that gained/lost components since the last Update()
+		UpdateSystemMembership();
+
 		// Add the entities that are waiting to be created to the active Systems
 		for (auto e : m_entitiesToBeAdded)
+		{
+			// Already destroyed by a delta (see ApplyDeltaEntities())
+			if (!IsValid(e))
+				continue;
+
 			AddEntityToSystems(e);
+			m_systemSyncPending[GetEntityIndex(e.GetId())] = false;
+		}
 		m_entitiesToBeAdded.clear();
 
 		// Process the entities that are waiting to be killed
 		for (auto e : m_entitiesToBeKilled)
 		{
-			if (!IsValid(e))
+			if (IsValid(e))
+				DestroyEntity(e);
+		}
+		m_entitiesToBeKilled.clear();
+		FlushPoolRemovals();
+
+		// Removals stay visible until the end of the next Update()
+		for (auto& pool : m_componentPools)
+		{
+			if (pool && pool->GetChangeTracker())
+				pool->GetChangeTracker()->DiscardRemovals(m_currentTick);
+		}
+		auto isOld = [this](const EntityLogEntry& entry) { return entry.tick < m_currentTick; };
+		std::erase_if(m_createdEntityLog, isOld);
+		std::erase_if(m_killedEntityLog, isOld);
+		m_currentTick++;
+
+		// Last, so that the listeners see the frame fully applied
+		DispatchComponentEvents();
+
+#if ECS_ENABLE_PROFILING
+		m_profiler.Record("Registry::Update", updateStart, m_profiler.Now());
+		m_profiler.NextFrame(m_freeCount);
+#endif
+	}
+
+	void Registry::DestroyEntity(Entity e)
+	{
+		u32 index = GetEntityIndex(e.GetId());
+		ECS_PROFILE_COUNT(m_profiler, entitiesKilled, 1);
+
+		RemoveEntityFromSystems(e);
+		RemoveEntityFromQueries(e.GetId());
+
+		// Queue the removal only in the pools the entity has a component in
+		Signature& signature = m_entityComponentSignatures[index];
+		if (!m_observers.empty())
+		{
+			signature.ForEachSetBit([this, e](u32 componentId) {
+				QueueComponentEvent(ComponentEvent::Destroy, componentId, e.GetId());
+				});
+		}
+
+		if (m_archetypes)
+		{
+			m_archetypes->RemoveEntity(e.GetId());
+		}
+		else
+		{
+			signature.ForEachSetBit([this, e](u32 componentId) {
+				m_pendingPoolRemovals[componentId].push_back(e.GetId());
+				});
+		}
+		signature.reset();
+
+		RemoveEntityTag(e);
+		RemoveEntityGroup(e);
+
+		if (m_entityLogEnabled)
+			m_killedEntityLog.push_back({ e.GetId(), m_currentTick });
+
+		// Make the entity id available to be reused, with a newer version
+		ReleaseEntityIndex(index);
+	}
+
+	void Registry::FlushPoolRemovals()
+	{
+		// Remove the killed entities from the component pools, one batch per pool
+		for (u32 componentId = 0; componentId < m_pendingPoolRemovals.size(); ++componentId)
+		{
+			std::pmr::vector<EntityID>& removals = m_pendingPoolRemovals[componentId];
+			if (removals.empty())
 				continue;
 
-			u32 index = GetEntityIndex(e.GetId());
+			m_componentPools[componentId]->RemoveEntitiesFromPool(removals);
+			removals.clear();
+		}
+	}
+
+	CommandBuffer& Registry::CreateCommandBuffer()
+	{
+		return *m_commandBuffers.emplace_back(std::make_unique<CommandBuffer>());
+	}
+
+	void Registry::PlaybackCommandBuffers()
+	{
+		ECS_PROFILE_SCOPE(m_profiler, "Playback command buffers");
+
+		size_t createdCount = 0;
+		for (const auto& buffer : m_commandBuffers)
+			createdCount += buffer->m_createdCount;
 
+		// The entities of every buffer in one batch
+		m_playbackEntities.resize(createdCount);
+		if (createdCount)
+			CreateEntities(createdCount, m_playbackEntities);
 
-			RemoveEntityFromSystems(e);
-			m_entityComponentSignatures[index].reset();
+		// One pool growth per component type (buffer storages are indexed by Component<T>::GetId())
+		size_t typeCount = 0;
+		for (const auto& buffer : m_commandBuffers)
+			typeCount = std::max(typeCount, buffer->m_storages.size());
 
-			// Remove the entity from the component pools
-			for (auto& pool : m_componentPools)
+		for (u32 componentId = 0; componentId < typeCount; ++componentId)
+		{
+			size_t addCount = 0;
+			CommandBuffer::IComponentStorage* typed = nullptr;
+			for (const auto& buffer : m_commandBuffers)
 			{
-				if (pool)
-					pool->RemoveEntityFromPool(e.GetId());
+				if (componentId < buffer->m_storages.size() && buffer->m_storages[componentId])
+				{
+					typed = buffer->m_storages[componentId].get();
+					addCount += typed->GetSize();
+				}
 			}
 
-			RemoveEntityTag(e);
-			RemoveEntityGroup(e);
+			if (addCount)
+				typed->Reserve(*this, addCount);
+		}
+
+		size_t firstEntity = 0;
+		for (const auto& buffer : m_commandBuffers)
+		{
+			for (const CommandBuffer::Command& command : buffer->m_commands)
+			{
+				// A placeholder only means something in the buffer that created it
+				const bool placeholder = CommandBuffer::IsPlaceholder(command.entityId);
+				assert((!placeholder || GetEntityIndex(command.entityId) < buffer->m_createdCount) && "Placeholder entity of another command buffer");
+				if (placeholder && GetEntityIndex(command.entityId) >= buffer->m_createdCount)
+					continue;
 
-			m_entityVersions[index]++;
+				Entity e = placeholder
+					? m_playbackEntities[firstEntity + GetEntityIndex(command.entityId)]
+					: Entity(command.entityId, this);
 
-			// Make the entity id available to be reused
-			m_freeIndices.emplace_back(index);
+				if (!IsValid(e))
+					continue;
+
+				switch (command.type)
+				{
+				case CommandBuffer::CommandType::Kill:
+					KillEntity(e);
+					break;
+				case CommandBuffer::CommandType::AddComponent:
+					buffer->m_storages[command.componentId]->Add(*this, e, command.valueIndex);
+					break;
+				case CommandBuffer::CommandType::RemoveComponent:
+					buffer->m_storages[command.componentId]->Remove(*this, e);
+					break;
+				}
+			}
+
+			firstEntity += buffer->m_createdCount;
+			buffer->Clear();
+		}
+	}
+
+	void Registry::DispatchComponentEvents()
+	{
+		ECS_PROFILE_SCOPE(m_profiler, "Dispatch component events");
+
+		for (ComponentObservers& observers : m_observers)
+		{
+			for (size_t event = 0; event < (size_t)ComponentEvent::Count; ++event)
+			{
+				std::vector<EntityID>& pending = observers.pending[event];
+				if (pending.empty())
+					continue;
+
+				// An entity is reported once per update batch, however many times it changed
+				if (event == (size_t)ComponentEvent::Update)
+				{
+					std::sort(pending.begin(), pending.end());
+					pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+				}
+
+				// Events raised by the listeners themselves go to the next Update()
+				observers.dispatching[event].swap(pending);
+				for (const ComponentListener& listener : observers.listeners[event])
+					listener(observers.dispatching[event]);
+				observers.dispatching[event].clear();
+			}
 		}
-		m_entitiesToBeKilled.clear();
 	}
 
 	void Registry::AddEntityToSystems(Entity e)
@@ -83,102 +277,531 @@ namespace ECS
 		u32 index = GetEntityIndex(entityId);
 		const auto& entityComponentSignature = m_entityComponentSignatures[index];
 
-		for (auto& system : m_systems)
+		for (System* system : m_systemsWithoutComponents)
+			system->AddEntityToSystem(e);
+
+		// Only the systems requiring one of the entity components can match, like
+		// UpdateSystemMembership(). A system is met once per component it requires.
+		entityComponentSignature.ForEachSetBit([&](u32 componentId) {
+			if (componentId >= m_systemsByComponent.size())
+				return;
+
+			for (System* system : m_systemsByComponent[componentId])
+			{
+				if (entityComponentSignature.Contains(system->GetComponentSignature()))
+					system->AddEntityToSystem(e); // Ignores duplicates
+			}
+			});
+	}
+
+	void Registry::UpdateSystemMembership()
+	{
+		ECS_PROFILE_SCOPE(m_profiler, "Update system membership");
+
+		for (const SignatureChange& change : m_signatureChanges)
+		{
+			const u32 index = GetEntityIndex(change.entityId);
+			m_systemSyncPending[index] = false;
+
+			// Killed since, the kill will remove it from its systems
+			if (!IsValid(Entity(change.entityId)))
+				continue;
+
+			const Signature& signature = m_entityComponentSignatures[index];
+			Signature changed = change.previous ^ signature;
+
+			// Only the systems requiring a changed component can gain or lose the entity
+			Entity e(change.entityId, this);
+			changed.ForEachSetBit([&](u32 componentId) {
+				if (componentId >= m_systemsByComponent.size())
+					return;
+
+				for (System* system : m_systemsByComponent[componentId])
+				{
+					if (signature.Contains(system->GetComponentSignature()))
+						system->AddEntityToSystem(e); // Ignores duplicates
+					else
+						system->RemoveEntityFromSystem(e); // No-op for non members
+				}
+				});
+		}
+		m_signatureChanges.clear();
+	}
+
+	void Registry::BuildSystemIndex()
+	{
+		m_systemsByComponent.assign(MAX_COMPONENTS, {});
+		m_systemsWithoutComponents.clear();
+		for (const auto& system : m_systemOrder)
+		{
+			if (system->GetComponentSignature().none())
+				m_systemsWithoutComponents.push_back(system.get());
+
+			system->GetComponentSignature().ForEachSetBit([this, &system](u32 componentId) {
+				m_systemsByComponent[componentId].push_back(system.get());
+				});
+		}
+
+		m_systemIndexDirty = false;
+	}
+
+	u32 Registry::AssignComponentId(u64 typeId)
+	{
+		if (typeId >= m_componentIds.size())
+			m_componentIds.resize(typeId + 1, u32_invalid_id);
+
+		u32& componentId = m_componentIds[typeId];
+		if (componentId == u32_invalid_id)
+		{
+			assert(m_componentCount < MAX_COMPONENTS && "Too many component types in this registry, raise ECS_MAX_COMPONENTS");
+			componentId = m_componentCount++;
+		}
+
+		return componentId;
+	}
+
+	void Registry::BindSystem(System& system)
+	{
+		system.m_componentSignature.reset();
+		system.m_readSignature.reset();
+		system.m_writeSignature.reset();
+
+		for (const System::ComponentAccess& access : system.m_componentAccesses)
+		{
+			const u32 componentId = AssignComponentId(access.typeId);
+			system.m_componentSignature.set(componentId);
+			if (access.write)
+				system.m_writeSignature.set(componentId);
+			else
+				system.m_readSignature.set(componentId);
+		}
+	}
+
+	void Registry::TrackSignatureChange(EntityID entityId, const Signature& previous)
+	{
+		const u32 index = GetEntityIndex(entityId);
+		if (m_systemSyncPending[index])
+			return;
+
+		m_systemSyncPending[index] = true;
+		m_signatureChanges.push_back({ entityId, previous });
+	}
+
+	void Registry::OnComponentAdded(EntityID entityId, u32 componentId)
+	{
+		Signature& signature = m_entityComponentSignatures[GetEntityIndex(entityId)];
+		if (signature.test(componentId))
+			return;
+
+		TrackSignatureChange(entityId, signature);
+		signature.set(componentId);
+		ECS_PROFILE_COUNT(m_profiler, componentsAdded, 1);
+		QueueComponentEvent(ComponentEvent::Construct, componentId, entityId);
+
+		// Only the queries using this component can start matching
+		if (componentId < m_queriesByComponent.size())
 		{
-			const auto& systemComponentSignature = system.second->GetComponentSignature();
-			bool isInterested = (entityComponentSignature & systemComponentSignature) == systemComponentSignature;
+			for (QueryState* query : m_queriesByComponent[componentId])
+			{
+				if (signature.Contains(query->GetSignature()))
+					query->Add(entityId);
+			}
+		}
+	}
+
+	void Registry::OnComponentRemoved(EntityID entityId, u32 componentId)
+	{
+		Signature& signature = m_entityComponentSignatures[GetEntityIndex(entityId)];
+		if (!signature.test(componentId))
+			return;
+
+		TrackSignatureChange(entityId, signature);
+		signature.set(componentId, false);
+		ECS_PROFILE_COUNT(m_profiler, componentsRemoved, 1);
+		QueueComponentEvent(ComponentEvent::Destroy, componentId, entityId);
 
-			if (isInterested)
-				system.second->AddEntityToSystem(e);
+		if (componentId < m_queriesByComponent.size())
+		{
+			for (QueryState* query : m_queriesByComponent[componentId])
+				query->Remove(entityId);
 		}
 	}
 
+	void Registry::RemoveEntityFromQueries(EntityID entityId)
+	{
+		if (m_queries.empty())
+			return;
+
+		const Signature& signature = m_entityComponentSignatures[GetEntityIndex(entityId)];
+		signature.ForEachSetBit([this, entityId](u32 componentId) {
+			if (componentId < m_queriesByComponent.size())
+			{
+				for (QueryState* query : m_queriesByComponent[componentId])
+					query->Remove(entityId);
+			}
+			});
+	}
+
 	void Registry::RemoveEntityFromSystems(Entity e)
 	{
-		for (auto& system : m_systems)
-			system.second->RemoveEntityFromSystem(e);
+		const u32 index = GetEntityIndex(e.GetId());
+
+		// The memberships still follow an older signature (killed by a delta before the next
+		// Update()), or the index is stale: try every system
+		if (m_systemSyncPending[index] || m_systemIndexDirty)
+		{
+			for (auto& system : m_systems)
+				system.second->RemoveEntityFromSystem(e);
+			return;
+		}
+
+		// Only the systems requiring one of the entity components can have it.
+		// O(1) per system, and a no-op (no Remove callback) for systems the entity is not in
+		for (System* system : m_systemsWithoutComponents)
+			system->RemoveEntityFromSystem(e);
+
+		m_entityComponentSignatures[index].ForEachSetBit([this, e](u32 componentId) {
+			if (componentId >= m_systemsByComponent.size())
+				return;
+
+			for (System* system : m_systemsByComponent[componentId])
+				system->RemoveEntityFromSystem(e);
+			});
+	}
+
+	void Registry::RunSystems(f32 deltaTime)
+	{
+		if (m_systemGraphDirty)
+			BuildSystemGraph();
+
+		const size_t systemCount = m_systemOrder.size();
+		if (systemCount == 0)
+			return;
+
+		ThreadPool& threadPool = GetThreadPool();
+
+		// Dependencies left per system for this frame
+		std::unique_ptr<std::atomic<u32>[]> pending = std::make_unique<std::atomic<u32>[]>(systemCount);
+		for (size_t i = 0; i < systemCount; ++i)
+			pending[i].store(m_systemGraph[i].dependencyCount, std::memory_order_relaxed);
+
+		std::atomic<size_t> remaining = systemCount;
+
+		std::function<void(u32)> runSystem = [&](u32 node) {
+			{
+				System& system = *m_systemOrder[node];
+#if ECS_ENABLE_PROFILING
+				ProfileScope scope(m_profiler, system.GetName());
+				scope.SetEntityCount((u32)system.GetSystemEntities().size());
+#endif
+				system.Update(deltaTime);
+			}
+
+			// Release the dependents whose last dependency just finished
+			for (u32 dependent : m_systemGraph[node].dependents)
+			{
+				if (pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					threadPool.Submit([&runSystem, dependent]() { runSystem(dependent); });
+			}
+
+			remaining.fetch_sub(1, std::memory_order_release);
+			};
+
+		for (u32 node = 0; node < (u32)systemCount; ++node)
+		{
+			if (m_systemGraph[node].dependencyCount == 0)
+				threadPool.Submit([&runSystem, node]() { runSystem(node); });
+		}
+
+		// Help the workers until the whole graph has run
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			if (!threadPool.RunPendingTask())
+				std::this_thread::yield();
+		}
+	}
+
+	void Registry::BuildSystemGraph()
+	{
+		const u32 systemCount = (u32)m_systemOrder.size();
+		m_systemGraph.assign(systemCount, SystemNode{});
+
+		// A system waits for every previously added system it conflicts with
+		for (u32 i = 0; i < systemCount; ++i)
+		{
+			for (u32 j = 0; j < i; ++j)
+			{
+				if (m_systemOrder[j]->ConflictsWith(*m_systemOrder[i]))
+				{
+					m_systemGraph[j].dependents.push_back(i);
+					m_systemGraph[i].dependencyCount++;
+				}
+			}
+		}
+
+		m_systemGraphDirty = false;
 	}
 
 	Entity Registry::CreateEntity()
 	{
 		u32 index;
 
-		if (m_freeIndices.empty())
+		if (m_freeHead == u32_invalid_id)
 		{
 			// No free ids, so we add one more
-			index = m_numEntities++;
+			index = (u32)m_numEntities++;
 
-			if (index >= m_entityVersions.size())
-			{
-				m_entityVersions.resize(index + 1, 0);
-				if (index >= m_entityComponentSignatures.size())
-					m_entityComponentSignatures.resize(index + 1);
-			}
+			if (index >= m_entitySlots.size())
+				GrowEntities(index + 1);
+
+			// Build the entity id by combining the index and the version
+			m_entitySlots[index] = CreateEntityId(index, GetEntityVersion(m_entitySlots[index]));
 		}
 		else
 		{
-			index = m_freeIndices.front();
-			m_freeIndices.pop_front();
+			index = PopFreeIndex();
 		}
 
-		// Build the entity id by combining the index and the version
-		u32 version = m_entityVersions[index];
-		EntityID id = CreateEntityId(index, version);
+		EntityID id = m_entitySlots[index];
+
+		// Systems see the entity as a whole in the next Update(), no need to track its changes
+		m_systemSyncPending[index] = true;
 
 		Entity entity(id, this);
-		m_entitiesToBeAdded.insert(entity);
+		m_entitiesToBeAdded.push_back(entity);
+		ECS_PROFILE_COUNT(m_profiler, entitiesCreated, 1);
+
+		if (m_entityLogEnabled)
+			m_createdEntityLog.push_back({ id, m_currentTick });
 
 		return entity;
 	}
 
+	void Registry::CreateEntities(size_t count, std::span<Entity> out)
+	{
+		assert(out.size() >= count && "Output span is too small");
+
+		// Recycled indices first
+		const size_t recycledCount = std::min(count, (size_t)m_freeCount);
+		for (size_t i = 0; i < recycledCount; ++i)
+			out[i] = Entity(m_entitySlots[PopFreeIndex()], this);
+
+		// Then new indices, growing the arrays once
+		const u32 firstIndex = (u32)m_numEntities;
+		m_numEntities += (int)(count - recycledCount);
+		GrowEntities(m_numEntities);
+
+		for (size_t i = recycledCount; i < count; ++i)
+		{
+			u32 index = firstIndex + (u32)(i - recycledCount);
+			m_entitySlots[index] = CreateEntityId(index, GetEntityVersion(m_entitySlots[index]));
+			out[i] = Entity(m_entitySlots[index], this);
+		}
+
+		for (size_t i = 0; i < count; ++i)
+			m_systemSyncPending[GetEntityIndex(out[i].GetId())] = true;
+
+		m_entitiesToBeAdded.insert(m_entitiesToBeAdded.end(), out.begin(), out.begin() + count);
+		ECS_PROFILE_COUNT(m_profiler, entitiesCreated, count);
+
+		if (m_entityLogEnabled)
+		{
+			for (size_t i = 0; i < count; ++i)
+				m_createdEntityLog.push_back({ out[i].GetId(), m_currentTick });
+		}
+	}
+
 	void Registry::KillEntity(Entity e)
 	{
 		if (!IsValid(e))
 			return;
 
-		m_entitiesToBeKilled.insert(e);
+		// Duplicates are skipped in Update(), the version no longer matches after the first kill
+		m_entitiesToBeKilled.push_back(e);
+	}
+
+	void Registry::KillEntities(std::span<const Entity> entities)
+	{
+		m_entitiesToBeKilled.reserve(m_entitiesToBeKilled.size() + entities.size());
+
+		for (const Entity& e : entities)
+		{
+			if (IsValid(e))
+				m_entitiesToBeKilled.push_back(e);
+		}
 	}
 
 	bool Registry::IsValid(Entity e) const
 	{
 		u32 index = GetEntityIndex(e.GetId());
-		if (index >= m_entityVersions.size())
+		if (index >= m_entitySlots.size())
 			return false;
 
-		// Valid only if the version matches the one stored in the registry (if not, it means the entity was killed and its id was reused for a new entity)
-		return m_entityVersions[index] == GetEntityVersion(e.GetId());
+		// Valid only if the slot holds this exact id (if not, the entity was killed: the slot is free, retired, or its id was reused with a newer version)
+		return m_entitySlots[index] == e.GetId();
+	}
+
+	void Registry::Reserve(size_t entityCount)
+	{
+		ResizeEntities(entityCount);
+	}
+
+	void Registry::SetVersionOverflow(VersionOverflow overflow, u32 maxVersion)
+	{
+		assert(maxVersion <= MAX_ENTITY_VERSION && "u32_invalid_id is a reserved version");
+		m_versionOverflow = overflow;
+		m_maxEntityVersion = maxVersion;
+	}
+
+	void Registry::GrowEntities(size_t count)
+	{
+		if (count > m_entitySlots.size())
+			ResizeEntities(std::max({ count, m_entitySlots.size() * 2, (size_t)64 }));
+	}
+
+	void Registry::ResizeEntities(size_t count)
+	{
+		if (count <= m_entitySlots.size())
+			return;
+
+		// Never-used indices: not alive (the index part is not theirs), next version 0
+		m_entitySlots.resize(count, CreateEntityId(u32_invalid_id, 0));
+		m_systemSyncPending.resize(count);
+		if (count > m_entityComponentSignatures.size())
+			m_entityComponentSignatures.resize(count);
+	}
+
+	void Registry::PushFreeIndex(u32 index, u32 version)
+	{
+		m_entitySlots[index] = CreateEntityId(m_freeHead, version);
+		m_freeHead = index;
+		m_freeCount++;
+	}
+
+	u32 Registry::PopFreeIndex()
+	{
+		const u32 index = m_freeHead;
+		const EntityID slot = m_entitySlots[index];
+		m_freeHead = GetEntityIndex(slot);
+		m_freeCount--;
+
+		m_entitySlots[index] = CreateEntityId(index, GetEntityVersion(slot));
+		return index;
+	}
+
+	void Registry::ReleaseEntityIndex(u32 index)
+	{
+		const u32 version = GetEntityVersion(m_entitySlots[index]);
+		if (version < m_maxEntityVersion)
+			PushFreeIndex(index, version + 1);
+		else if (m_versionOverflow == VersionOverflow::Wrap)
+			PushFreeIndex(index, 0);
+		else
+			m_entitySlots[index] = CreateEntityId(u32_invalid_id, u32_invalid_id);
+	}
+
+	// Threading
+	void Registry::SetThreadPool(std::shared_ptr<ThreadPool> threadPool)
+	{
+		m_threadPool = std::move(threadPool);
+	}
+
+	ThreadPool& Registry::GetThreadPool()
+	{
+		if (!m_threadPool)
+			m_threadPool = std::make_shared<ThreadPool>();
+
+		return *m_threadPool;
+	}
+
+	void Registry::TrimMemory()
+	{
+		for (auto& pool : m_componentPools)
+		{
+			if (pool)
+				pool->ShrinkToFit();
+		}
+		for (auto& group : m_groups)
+			group->sparse.ShrinkToFit();
+
+		m_pageAllocator->Trim();
+	}
+
+	std::vector<PoolStats> Registry::GetPoolStats() const
+	{
+		std::vector<PoolStats> stats;
+		for (u32 componentId = 0; componentId < m_componentPools.size(); ++componentId)
+		{
+			if (!m_componentPools[componentId])
+				continue;
+
+			PoolStats& poolStats = stats.emplace_back();
+			m_componentPools[componentId]->GetStats(poolStats);
+			poolStats.componentId = componentId;
+		}
+		return stats;
+	}
+
+	// Tag and group names
+	void Registry::RegisterName([[maybe_unused]] Name name)
+	{
+#ifndef NDEBUG
+		assert(name.GetHash() != 0 && "Name hash 0 is reserved");
+
+		auto [it, inserted] = m_names.try_emplace(name.GetHash(), name.GetString());
+		assert((inserted || it->second == name.GetString()) && "Tag or group name hash collision");
+#endif
+	}
+
+	void Registry::CheckName([[maybe_unused]] Name name) const
+	{
+#ifndef NDEBUG
+		auto it = m_names.find(name.GetHash());
+		assert((it == m_names.end() || it->second == name.GetString()) && "Tag or group name hash collision");
+#endif
 	}
 
 	// Tag management
-	void Registry::TagEntity(Entity e, const char* tag)
+	void Registry::TagEntity(Entity e, Name tag)
 	{
+		RegisterName(tag);
+
 		u32 index = GetEntityIndex(e.GetId());
-		u32 hash = HashString(tag);
+		u32 hash = tag.GetHash();
 
 		// Sparse Vector (Entity -> Hash)
 		if (index >= m_entityToTag.size())
 			m_entityToTag.resize(index + 1, 0);
 
+		// One tag per entity and one entity per tag
+		RemoveEntityTag(e);
+		auto it = m_tagToEntity.find(hash);
+		if (it != m_tagToEntity.end())
+			m_entityToTag[GetEntityIndex(it->second)] = 0;
+
 		m_entityToTag[index] = hash;
 
 		// Map (Hash -> Entity)
 		m_tagToEntity[hash] = e.GetId();
 	}
 
-	bool Registry::EntityHasTag(Entity e, const char* tag) const
+	bool Registry::EntityHasTag(Entity e, Name tag) const
 	{
+		CheckName(tag);
+
 		u32 index = GetEntityIndex(e.GetId());
 
 		if (index >= m_entityToTag.size())
 			return false;
 
-		return m_entityToTag[index] == HashString(tag);
+		return m_entityToTag[index] == tag.GetHash();
 	}
 
-	Entity Registry::GetEntityByTag(const char* tag)
+	Entity Registry::GetEntityByTag(Name tag)
 	{
-		u32 hash = HashString(tag);
-		auto it = m_tagToEntity.find(hash);
+		CheckName(tag);
+
+		auto it = m_tagToEntity.find(tag.GetHash());
 		if (it != m_tagToEntity.end())
 			return Entity(it->second, this);
 
@@ -201,101 +824,117 @@ namespace ECS
 	}
 
 	// Group management
-	void Registry::GroupEntity(Entity e, const char* groupName)
+	u32 Registry::FindGroup(u32 hash) const
+	{
+		auto it = std::lower_bound(m_groupLookup.begin(), m_groupLookup.end(), hash,
+			[](const std::pair<u32, u32>& entry, u32 value) { return entry.first < value; });
+		if (it == m_groupLookup.end() || it->first != hash)
+			return u32_invalid_id;
+
+		return it->second;
+	}
+
+	void Registry::GroupEntity(Entity e, Name groupName)
 	{
-		u32 groupHash = HashString(groupName);
-		GroupData& group = m_groups[groupHash];
-		EntityID id = e.GetId();
+		u32 groupIndex = FindGroup(groupName.GetHash());
+		if (groupIndex == u32_invalid_id)
+		{
+			RegisterName(groupName);
+
+			groupIndex = (u32)m_groups.size();
+			m_groups.emplace_back(MakeResourceUnique<GroupData>(m_memoryResource, *m_pageAllocator, m_memoryResource));
+
+			auto it = std::lower_bound(m_groupLookup.begin(), m_groupLookup.end(), groupName.GetHash(),
+				[](const std::pair<u32, u32>& entry, u32 value) { return entry.first < value; });
+			m_groupLookup.insert(it, { groupName.GetHash(), groupIndex });
+		}
+		else
+		{
+			CheckName(groupName);
+		}
+
+		GroupData& group = *m_groups[groupIndex];
 		u32 index = GetEntityIndex(e.GetId());
 
 		// Avoid duplication in a group
-		if (group.entityToIndex.find(id) != group.entityToIndex.end())
+		if (group.sparse.Get(index) != u32_invalid_id)
 			return;
 
+		group.sparse.Set(index, (u32)group.entities.size());
 		group.entities.push_back(e);
-		group.entityToIndex[id] = (int)group.entities.size() - 1;
-
-		// Reverse Lookup Optimization
-		if (index >= m_entityGroups.size())
-			m_entityGroups.resize(index + 1);
-
-		m_entityGroups[index].push_back(groupHash);
 	}
 
-	bool Registry::EntityBelongsToGroup(Entity e, const char* groupName) const
+	bool Registry::EntityBelongsToGroup(Entity e, Name groupName) const
 	{
-		u32 hash = HashString(groupName);
-		auto it = m_groups.find(hash);
-		if (it == m_groups.end())
+		CheckName(groupName);
+
+		u32 groupIndex = FindGroup(groupName.GetHash());
+		if (groupIndex == u32_invalid_id)
 			return false;
 
-		return it->second.entityToIndex.find(e.GetId()) != it->second.entityToIndex.end();
+		return m_groups[groupIndex]->sparse.Get(GetEntityIndex(e.GetId())) != u32_invalid_id;
 	}
 
-	const std::vector<Entity>& Registry::GetEntitiesByGroup(const char* groupName)
+	std::span<const Entity> Registry::GetEntitiesByGroup(Name groupName) const
 	{
-		return m_groups[HashString(groupName)].entities;
+		CheckName(groupName);
+
+		u32 groupIndex = FindGroup(groupName.GetHash());
+		if (groupIndex == u32_invalid_id)
+			return {};
+
+		return m_groups[groupIndex]->entities;
 	}
 
 	void Registry::RemoveEntityGroup(Entity e)
 	{
-		EntityID id = e.GetId();
-		u32 index = GetEntityIndex(id);
-
-		if (index >= m_entityGroups.size()) return;
-
-		// Only on groups of the entity
-		std::vector<u32>& groupsOfEntity = m_entityGroups[index];
+		u32 index = GetEntityIndex(e.GetId());
 
-		for (u32 groupHash : groupsOfEntity)
+		for (ResourcePtr<GroupData>& group : m_groups)
 		{
-			auto itGroup = m_groups.find(groupHash);
-			if (itGroup != m_groups.end())
-			{
-				GroupData& group = itGroup->second;
-				auto itIndex = group.entityToIndex.find(id);
+			u32 indexToRemove = group->sparse.Get(index);
+			if (indexToRemove == u32_invalid_id)
+				continue;
 
-				if (itIndex != group.entityToIndex.end())
-				{
-					// Swap & Pop Logic
-					int indexToRemove = itIndex->second;
-					int indexLast = (int)group.entities.size() - 1;
-
-					if (indexToRemove != indexLast)
-					{
-						Entity lastEntity = group.entities[indexLast];
-						group.entities[indexToRemove] = lastEntity;
-						group.entityToIndex[lastEntity.GetId()] = indexToRemove;
-					}
-
-					group.entities.pop_back();
-					group.entityToIndex.erase(itIndex);
-				}
+			// Swap & Pop Logic
+			u32 indexLast = (u32)group->entities.size() - 1;
+			if (indexToRemove != indexLast)
+			{
+				Entity lastEntity = group->entities[indexLast];
+				group->entities[indexToRemove] = lastEntity;
+				group->sparse.Set(GetEntityIndex(lastEntity.GetId()), indexToRemove);
 			}
+
+			group->entities.pop_back();
+			group->sparse.Reset(index);
 		}
+	}
 
-		groupsOfEntity.clear();
+	void Registry::Fatal(const char* message)
+	{
+		std::fprintf(stderr, "ECS: %s\n", message);
+		std::abort();
 	}
 
 	// Manage entity tags
-	void Entity::Tag(const std::string& tag)
+	void Entity::Tag(Name tag)
 	{
-		registry->TagEntity(*this, tag.c_str());
+		registry->TagEntity(*this, tag);
 	}
 
-	bool Entity::HasTag(const std::string& tag) const
+	bool Entity::HasTag(Name tag) const
 	{
-		return registry->EntityHasTag(*this, tag.c_str());
+		return registry->EntityHasTag(*this, tag);
 	}
 
 	// Manage entity groups
-	void Entity::Group(const std::string& groupName)
+	void Entity::Group(Name groupName)
 	{
-		registry->GroupEntity(*this, groupName.c_str());
+		registry->GroupEntity(*this, groupName);
 	}
 
-	bool Entity::BelongsToGroup(const std::string& groupName) const
+	bool Entity::BelongsToGroup(Name groupName) const
 	{
-		return registry->EntityBelongsToGroup(*this, groupName.c_str());
+		return registry->EntityBelongsToGroup(*this, groupName);
 	}
 }
\ No newline at end of file
@@ -27,11 +27,25 @@ SOFTWARE.
 #include "Common.h"
 #include "Entity.h"
 #include "Pool.h"
+#include "ArchetypeStorage.h"
+#include "OwningGroup.h"
+#include "ThreadPool.h"
+#include "Query.h"
+#include "CommandBuffer.h"
+#include "Snapshot.h"
+#include "Delta.h"
+#include "ViewModifiers.h"
+#include "Profiler.h"
+
+#include <functional>
+#include <array>
 #include "System.h"
 #include "Component.h"
 
 namespace ECS
 {
+	// Receives a batch of entities, see Registry::OnConstruct()
+	using ComponentListener = std::function<void(std::span<const EntityID>)>;
 
 	class Registry
 	{
@@ -40,14 +54,114 @@ namespace ECS
 		 * @brief Construct a new Registry object.
 		 *
 		 * The Registry manages entities, components, systems, tags and groups.
+		 *
+		 * With StorageMode::Archetype, entities sharing the same components are stored
+		 * together in chunked SoA archetypes: views walk contiguous columns, at the price of
+		 * moving the entity to another archetype on every AddComponent()/RemoveComponent().
+		 * OwnGroup() and SetPoolPageSize() only apply to StorageMode::SparseSet.
+		 *
+		 * The pools (the pool objects, packed arrays, sparse pages and change ticks), the
+		 * archetypes and their chunks, the entity groups and the per-entity containers of the
+		 * registry allocate from the given memory resource, e.g. a monotonic_buffer_resource
+		 * per world or an unsynchronized_pool_resource per thread. The resource must outlive
+		 * the registry. Systems, queries, observers, owning groups and command buffers keep
+		 * using the global heap.
+		 *
+		 * @param storageMode How components are stored.
+		 * @param resource Memory resource of the registry, the default resource if not set.
+		 */
+		explicit Registry(StorageMode storageMode = StorageMode::SparseSet, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/**
+		 * @brief Construct a new Registry object in StorageMode::SparseSet allocating from a memory resource.
+		 *
+		 * @param resource Memory resource of the registry.
+		 */
+		explicit Registry(std::pmr::memory_resource* resource) : Registry(StorageMode::SparseSet, resource) {}
+
+		/**
+		 * @brief Get the memory resource chosen at construction.
+		 *
+		 * @return std::pmr::memory_resource* The memory resource.
+		 */
+		std::pmr::memory_resource* GetMemoryResource() const { return m_memoryResource; }
+
+		// Component ids
+		/**
+		 * @brief Give registry component ids to component types up front, in the given order.
+		 *
+		 * Every registry has its own component ids, handed out on first use of a type, so pools,
+		 * signatures and observers are sized by the types this registry uses rather than by every
+		 * type of the process (up to ECS_MAX_COMPONENTS types per registry). Registering the
+		 * types of a world at creation, like a world template, makes its ids deterministic and
+		 * sizes the tables once. Types already used keep their id.
+		 *
+		 * @tparam Components Component types to register.
+		 */
+		template<typename... Components> void RegisterComponents();
+
+		/**
+		 * @brief Get the registry component id of a type, the bit used in signatures.
+		 *
+		 * @tparam T Component type.
+		 * @return u32 The id, u32_invalid_id if the type was never used in this registry.
+		 */
+		template<typename T> u32 GetComponentId() const
+		{
+			const u64 typeId = Component<T>::GetId();
+			return typeId < m_componentIds.size() ? m_componentIds[typeId] : u32_invalid_id;
+		}
+
+		/**
+		 * @brief Get the number of component types used by this registry.
+		 *
+		 * @return u32 Number of registry component ids handed out.
+		 */
+		u32 GetComponentCount() const { return m_componentCount; }
+
+		/**
+		 * @brief Get the storage mode chosen at construction.
+		 *
+		 * @return StorageMode The storage mode.
 		 */
-		Registry() = default;
+		StorageMode GetStorageMode() const { return m_storageMode; }
+
+		// Instrumentation
+		/**
+		 * @brief Get the profiler of the registry (see Profiler.h).
+		 *
+		 * Built with ECS_ENABLE_PROFILING, the registry records the time of Update() and its
+		 * phases, of every system in RunSystems() and of every view with the number of entities
+		 * passed to func, and counts the structural changes of each frame. Without it, the
+		 * hooks compile to nothing and the profiler stays empty.
+		 *
+		 * @return Profiler& The profiler.
+		 */
+		Profiler& GetProfiler() { return m_profiler; }
+		const Profiler& GetProfiler() const { return m_profiler; }
+
+		/**
+		 * @brief Get the memory used by each component pool, available in every build.
+		 *	Empty in StorageMode::Archetype.
+		 * @return std::vector<PoolStats> One entry per pool, by component id.
+		 */
+		std::vector<PoolStats> GetPoolStats() const;
+
+		/**
+		 * @brief Get the number of entity ids in the free list, waiting to be reused.
+		 *
+		 * @return size_t The free list length.
+		 */
+		size_t GetFreeEntityCount() const { return m_freeCount; }
 
 		/**
 		 * @brief Apply pending entity creation and destruction and update internal state.
 		 *
 		 * This will process entities queued via CreateEntity() / KillEntity() and
 		 * update system membership, free index pools and internal versioning.
+		 *
+		 * Entities whose components were added/removed since the previous Update() join or
+		 * leave the systems interested in the changed components.
 		 */
 		void Update();
 
@@ -63,6 +177,17 @@ namespace ECS
 		 */
 		Entity CreateEntity();
 
+		/**
+		 * @brief Create several entities at once.
+		 *
+		 * Same as calling CreateEntity() count times, but the internal arrays grow once
+		 * for the whole batch.
+		 *
+		 * @param count Number of entities to create.
+		 * @param out Receives the created entities, must hold at least count elements.
+		 */
+		void CreateEntities(size_t count, std::span<Entity> out);
+
 		/**
 		 * @brief Mark an entity to be destroyed.
 		 *
@@ -73,27 +198,288 @@ namespace ECS
 		 */
 		void KillEntity(Entity e);
 
+		/**
+		 * @brief Mark several entities to be destroyed.
+		 *
+		 * Same as calling KillEntity() on each of them.
+		 *
+		 * @param entities The entities to destroy.
+		 */
+		void KillEntities(std::span<const Entity> entities);
+
+		/**
+		 * @brief Reserve the per-entity arrays for entityCount entities in total.
+		 *
+		 * The arrays otherwise grow geometrically. Once reserved, creating entities does not
+		 * allocate, and killed indices are recycled through a free list stored in place.
+		 *
+		 * @param entityCount Number of entities to reserve storage for.
+		 */
+		void Reserve(size_t entityCount);
+
+		/**
+		 * @brief Reserve the per-entity arrays and the pools of the given component types.
+		 *	Pools are not reserved in StorageMode::Archetype, chunks are allocated as needed.
+		 * @tparam Components Component types to reserve.
+		 * @param entityCount Number of entities to reserve storage for.
+		 * @param componentCounts Number of components to reserve storage for, in the order of Components.
+		 */
+		template<typename... Components>
+		void Reserve(size_t entityCount, const std::array<size_t, sizeof...(Components)>& componentCounts);
+
+		/**
+		 * @brief Set what happens to an entity index killed at its highest version.
+		 *
+		 * The version of an index increases each time its entity is killed, so that the handles of
+		 * the killed entity are no longer valid. With VersionOverflow::Wrap (default) it restarts at 0
+		 * after maxVersion, with VersionOverflow::Retire the index is left out of the free list for good.
+		 *
+		 * @param overflow The overflow policy.
+		 * @param maxVersion Highest version, at most MAX_ENTITY_VERSION (u32_invalid_id is reserved).
+		 */
+		void SetVersionOverflow(VersionOverflow overflow, u32 maxVersion = MAX_ENTITY_VERSION);
+
+		/**
+		 * @brief Create a command buffer owned by the registry.
+		 *
+		 * The commands recorded in the registry buffers are played back at the start of every
+		 * Update(), buffer after buffer in creation order, so the result does not depend on
+		 * which thread filled which buffer first. Entities of all the buffers are created in one
+		 * batch and the pools grow once per component type. Commands on entities killed in the
+		 * meantime are skipped.
+		 *
+		 * Create the buffers up front (e.g. one per worker or per chunk), this call is not thread-safe.
+		 *
+		 * @return CommandBuffer& The buffer, valid as long as the registry.
+		 */
+		CommandBuffer& CreateCommandBuffer();
+
+		// Snapshots
+		/**
+		 * @brief Write the entities and the pools of the given components to a binary file.
+		 *
+		 * Entity versions, the free list and each pool's packed entity ids and components are
+		 * written as contiguous aligned blocks (see Snapshot.h). Pools are identified by
+		 * Component<T>::GetTypeHash(), so a snapshot can be loaded by another process.
+		 * Tags, groups, systems and the pools of other components are not saved.
+		 * Entities killed but not yet updated must be flushed with Update() first.
+		 *
+		 * @tparam Components Trivially copyable component types to save.
+		 * @param path File path.
+		 * @return true If the file was written.
+		 * @return false On I/O error.
+		 */
+		template<typename... Components> bool SaveSnapshot(const std::string& path) const;
+
+		/**
+		 * @brief Load a snapshot written by SaveSnapshot() into this empty registry.
+		 *
+		 * The file is memory-mapped and each pool block is copied in bulk, the sparse indices
+		 * and signatures are rebuilt in one pass. Entities, with their saved ids, join the
+		 * systems in the next Update() and Construct observers are notified there.
+		 * Pools of components that are not listed are skipped.
+		 *
+		 * @tparam Components Component types to load.
+		 * @param path File path.
+		 * @return true If the snapshot was loaded.
+		 * @return false If the file cannot be read or is not a valid snapshot, the registry is then left untouched.
+		 */
+		template<typename... Components> bool LoadSnapshot(const std::string& path);
+
+		// Deltas
+		/**
+		 * @brief Append to out the changes made since a tick to the entities and the given components.
+		 *
+		 * Built from change tracking (EnableChangeTracking() is needed on every listed type), pool
+		 * by pool: created and destroyed entity ids, then per pool the entities that lost the
+		 * component and the added or changed components, copied by runs of the packed array
+		 * (see Delta.h). Removals are only kept until the end of the next Update(), so deltas are
+		 * written every tick: after Update(), pass the GetTick() of the previous delta.
+		 * A sinceTick of 0 writes the full state, e.g. for a client that just joined.
+		 *
+		 * @tparam Components Trivially copyable component types to replicate.
+		 * @param sinceTick First tick to include, 0 for the full state.
+		 * @param out Destination buffer, the delta is appended.
+		 */
+		template<typename... Components> void WriteDelta(u32 sinceTick, std::vector<u8>& out) const;
+
+		/**
+		 * @brief Apply a delta written by WriteDelta() to this replica registry.
+		 *
+		 * Entities keep the sender ids, so the replica must not create entities on its own.
+		 * Destroyed entities are removed right away, created ones join the systems in the next
+		 * Update(), call it between two deltas.
+		 * Components are applied pool by pool and notify the observers like AddComponent(),
+		 * ReplaceComponent() and RemoveComponent(). Pools of components that are not listed are skipped.
+		 *
+		 * @tparam Components Component types to apply.
+		 * @param delta The delta bytes.
+		 * @return true If the delta was applied.
+		 * @return false If it is not a valid delta (the registry may then be partially updated).
+		 */
+		template<typename... Components> bool ApplyDelta(std::span<const u8> delta);
+
+		// Forks
+		/**
+		 * @brief Create a copy of the registry, e.g. to simulate ahead speculatively.
+		 *
+		 * The copy shares the memory resource and the thread pool of the registry, and has no
+		 * systems, queries, observers or command buffers of its own. See RestoreFrom().
+		 *
+		 * @return std::unique_ptr<Registry> The copy.
+		 */
+		std::unique_ptr<Registry> Clone() const;
+
+		/**
+		 * @brief Make this registry a copy of another one, reusing the allocations, e.g. to save
+		 *	or roll back a frame with a ring of registries.
+		 *
+		 * Entities, signatures, tags, groups, pools and change ticks are copied, the packed
+		 * arrays and sparse pages of trivially copyable components in bulk. A pool is skipped
+		 * (copy-on-write) when it is already a copy of the other registry's pool and none of the
+		 * two was accessed mutably since, so restoring a frame only pays for what changed.
+		 *
+		 * The systems, queries, observers and command buffers of this registry are kept: systems
+		 * and queries take the entities of their counterpart in the other registry (rebuilt from
+		 * the signatures if it has none) without Add()/Remove() callbacks, pending observer events
+		 * are dropped. Both registries must use StorageMode::SparseSet, have no owning group, and
+		 * share their component ids (as a clone does; one of them may have used more types since).
+		 *
+		 * @param other The registry to copy.
+		 * @return u32 Number of pools copied, the others were already up to date.
+		 */
+		u32 RestoreFrom(const Registry& other);
+
 		/**
 		 * @brief Iterate over all entities that have a specific set of components and apply a function to them.
 		 *
-		 * @note CRITICAL PERFORMANCE NOTE: The order of component types MATTERS.
-		 * The View iterates over the entities of the FIRST component type specified (the "Leader").
-		 * You should always list the rarest component first to minimize iterations.
+		 * The View iterates over the entities of the SMALLEST pool among the requested
+		 * component types (the "Leader"), picked at call time from Pool<T>::GetSize().
+		 * The other pools are only probed, so the order of the component types does not
+		 * affect performance.
 		 *
 		 * Example:
-		 * - View<Transform, Player>: Iterates over ALL Transforms (e.g., 10 000 entities) -> Checks for Player.
-		 * -> Slow (10 000 checks).
-		 * - View<Player, Transform>: Iterates over ONLY Players (e.g., 1 entity) -> Checks for Transform.
-		 * -> Fast (1 check).
+		 * - View<Transform, Player> with 10 000 Transforms and 1 Player iterates over the
+		 * Player pool only -> 1 check.
 		 *
-		 * In this example, <Player, Transform> is 10 000x faster than <Transform, Player>.
+		 * Components are always passed to the function in the declared order.
 		 *
-		 * @tparam Component The list of component types. Put the rarest one first!
+		 * @tparam Component The list of component types.
 		 * @tparam Func The function (lambda) to execute on each match.
+		 * In StorageMode::Archetype, the matching archetypes are iterated chunk by chunk instead.
+		 *
+		 * SoA components (see SoALayout) are passed as SoARef<Component> proxies.
+		 *
+		 * Exclude<Ts...> skips the entities having any of Ts and passes nothing to func,
+		 * Optional<Ts...> passes a Ts* per type, nullptr when the entity does not have it:
+		 * View<Enemy, Exclude<Dead>, Optional<Target>>([](EntityID, Enemy&, Target*) {}).
+		 * Membership is tested with one mask on the entity signature, the pools are only read
+		 * for the components passed to func. In StorageMode::Archetype, the same masks select the
+		 * archetypes and Optional<> columns are looked up once per chunk.
+		 *
 		 * @param func The lambda function taking (EntityID, Component&...).
 		 */
 		template<typename... Component, typename Func> void View(Func&& func);
 
+		/**
+		 * @brief Same as View(), with the change filters relative to a given tick.
+		 *
+		 * Component types can be wrapped in a filter (needs EnableChangeTracking() on the type):
+		 * - Added<T>: T was added at or after tick.
+		 * - Changed<T>: T was added, or changed through Pool::Set(), MarkChanged() or GetMutableComponent(), at or after tick.
+		 * - Removed<T>: T was removed at or after tick. Must be viewed alone, func only takes the EntityID
+		 *	(the entity may have been killed, or have T again since).
+		 * Filtered types are passed to func like plain ones. View() uses GetTick(), i.e. the changes
+		 * since the last Update(). Filters need StorageMode::SparseSet: in StorageMode::Archetype,
+		 * a filtered view prints an error and aborts, in every build.
+		 *
+		 * A const type (View<const T>, Changed<const T>) is passed as const T& and leaves its pool
+		 * untouched, so RestoreFrom() skips it when nothing else wrote to it.
+		 *
+		 * @param tick First tick to include (see GetTick()).
+		 * @param func The lambda function taking (EntityID, Component&...).
+		 */
+		template<typename... Component, typename Func> void ViewSince(u32 tick, Func&& func);
+
+		/**
+		 * @brief Same as View(), but the matching entities are processed in parallel.
+		 *
+		 * The leader range is split in chunks of grainSize entities, executed on the
+		 * registry thread pool (see SetThreadPool()). Chunking is deterministic, only the
+		 * thread executing a chunk changes between calls.
+		 *
+		 * The function must be safe to call concurrently for different entities, and must
+		 * not create/kill entities or add/remove components while the view runs.
+		 *
+		 * @tparam Component The list of component types.
+		 * @tparam Func The function (lambda) to execute on each match.
+		 * @param func The lambda function taking (EntityID, Component&...).
+		 * @param grainSize Number of leader entities per chunk.
+		 */
+		template<typename... Component, typename Func> void ParallelView(Func&& func, size_t grainSize = DEFAULT_GRAIN_SIZE);
+
+		/**
+		 * @brief Iterate over the matching entities in batches of contiguous components.
+		 *
+		 * The function receives the entity ids and one span per component type, all of the
+		 * same length. Every component span starts on a CACHE_LINE_SIZE boundary, so a batch
+		 * can be fed directly to vectorized kernels.
+		 *
+		 * The spans point into the storage when the components are laid out side by side: a single
+		 * component type, an owning group over exactly these types (see OwnGroup()), or any set of
+		 * types in StorageMode::Archetype (one batch per chunk). Other sets of types are gathered
+		 * into aligned scratch arrays and moved back once func returns, a copy each way.
+		 * In StorageMode::SparseSet, SoA components are not stored as Component arrays, use
+		 * ForEachField() instead (aborts otherwise).
+		 *
+		 * @tparam Component The list of component types.
+		 * @tparam Func The function (lambda) to execute on each batch.
+		 * @param func The lambda function taking (std::span<const EntityID>, std::span<Component>...).
+		 */
+		template<typename... Component, typename Func> void ForEachChunk(Func&& func);
+
+		/**
+		 * @brief Iterate over the field arrays of an SoA component (see SoALayout) in batches.
+		 *
+		 * Same batching and alignment as ForEachChunk(), with one span per requested field:
+		 * ForEachField<Transform, &Transform::position>([](std::span<const EntityID>, std::span<Vec3>) {}).
+		 * Only available in StorageMode::SparseSet.
+		 *
+		 * @tparam T SoA component type.
+		 * @tparam Members Member pointers of the fields to iterate.
+		 * @param func The lambda function taking (std::span<const EntityID>, std::span<Field>...).
+		 */
+		template<typename T, auto... Members, typename Func> void ForEachField(Func&& func);
+
+		/**
+		 * @brief Declare an owning group over a set of component types.
+		 *
+		 * The entities that have all the owned components are kept in the first
+		 * OwningGroup::GetSize() slots of each owned pool, in the same order. Pool Add/Remove
+		 * maintain that ordering, so a View over exactly these component types becomes a
+		 * linear walk over parallel arrays, without any sparse lookup.
+		 *
+		 * A component type can only be owned by a single group. Declaring the same group
+		 * twice returns the existing one.
+		 *
+		 * @tparam Owned The component types to own (at least two).
+		 * @return OwningGroup& The owning group.
+		 */
+		template<typename... Owned> OwningGroup& OwnGroup();
+
+		/**
+		 * @brief Get a persistent query over a set of component types.
+		 *
+		 * The query keeps a dense list of the entities having all the components. The list
+		 * is updated by AddComponent()/RemoveComponent() and Update() (killed entities) for
+		 * the queries using the changed component only, so iterating it with Query::Each()
+		 * does not test any entity. Creating the same query twice returns the same state.
+		 *
+		 * @tparam Component The list of component types.
+		 * @return Query<Component...> Handle to the query, valid as long as the registry.
+		 */
+		template<typename... Component> Query<Component...> CreateQuery();
+
 		// Component management
 		/**
 		 * @brief Add a component of type T to an entity.
@@ -108,6 +494,17 @@ namespace ECS
 		 */
 		template<typename T, typename ...TArgs> void AddComponent(Entity e, TArgs&& ...args);
 
+		/**
+		 * @brief Add a component of type T to several entities at once.
+		 *
+		 * The pool grows once for the whole batch.
+		 *
+		 * @tparam T Component type to add.
+		 * @param entities The entities to which the component will be added.
+		 * @param values One component value per entity, in the same order.
+		 */
+		template<typename T> void AddComponents(std::span<const Entity> entities, std::span<const T> values);
+
 		/**
 		 * @brief Remove a component of type T from an entity.
 		 *
@@ -116,6 +513,73 @@ namespace ECS
 		 */
 		template<typename T> void RemoveComponent(Entity e);
 
+		/**
+		 * @brief Reserve storage for count more components of type T.
+		 *	No-op in StorageMode::Archetype, chunks are allocated as needed.
+		 * @tparam T Component type.
+		 * @param count Number of components to add.
+		 */
+		template<typename T> void ReserveComponents(size_t count);
+
+		/**
+		 * @brief Set the number of entities per sparse page for the pool of T.
+		 *
+		 * Smaller pages waste less memory when the entities owning T have spread out
+		 * indices, larger pages mean fewer page allocations for dense pools.
+		 * Must be called while the pool is empty (e.g. before adding any T).
+		 *
+		 * @tparam T Component type.
+		 * @param pageSize Number of entities per page, must be a power of two.
+		 */
+		template<typename T> void SetPoolPageSize(u32 pageSize);
+
+		/**
+		 * @brief Give back the sparse pages kept for reuse.
+		 *
+		 * Each pool and group keeps its last emptied sparse page, and the page allocator of the
+		 * registry caches the released ones. Call this after a large despawn to return that memory
+		 * to the memory resource. The default allocator is shared, its whole cache is trimmed.
+		 */
+		void TrimMemory();
+
+		// Sorting
+		/**
+		 * @brief Sort the pool of T, e.g. to win back the locality swap-and-pop removals lose over time.
+		 *
+		 * The packed components and entity ids (and their change ticks) are permuted in place and
+		 * the sparse pages fixed up. Sort the most iterated pool, then SortAs() the pools viewed
+		 * with it so views walk them in the same order. Only in StorageMode::SparseSet, the pool
+		 * must not be owned by a group.
+		 *
+		 * @tparam T Component type.
+		 * @param compare compare(a, b), true if a comes first, called with two components
+		 *	(T& or SoARef<T>), or with two EntityID, e.g. std::less<EntityID>() for the spawn order.
+		 */
+		template<typename T, typename Compare> void Sort(Compare compare);
+
+		/**
+		 * @brief Sort the pool of T a few swaps at a time, to spread the work over frames.
+		 *
+		 * Insertion sort of the pool, stopped after maxSwaps swaps: cheap on a pool that is almost
+		 * sorted, so calling it every frame keeps up with the removals of the frame. Same
+		 * compare and conditions as Sort().
+		 *
+		 * @tparam T Component type.
+		 * @param compare See Sort().
+		 * @param maxSwaps Maximum number of swaps for this call.
+		 * @return true If the pool is sorted.
+		 * @return false If more calls are needed.
+		 */
+		template<typename T, typename Compare> bool SortIncremental(Compare compare, u32 maxSwaps);
+
+		/**
+		 * @brief Order the pool of T like the pool of U.
+		 *	The entities having both components come first, in the order of U, the others follow.
+		 * @tparam T Component type of the pool to sort.
+		 * @tparam U Component type of the pool giving the order.
+		 */
+		template<typename T, typename U> void SortAs();
+
 		/**
 		 * @brief Check whether an entity has a component of type T.
 		 *
@@ -130,13 +594,111 @@ namespace ECS
 		 * @brief Get a reference to an entity's component of type T.
 		 *
 		 * The caller must ensure the component exists (e.g. by calling
-		 * HasComponent<T>()).
+		 * HasComponent<T>()). The pool counts as modified for RestoreFrom(), use
+		 * GetConstComponent() to only read.
 		 *
 		 * @tparam T Component type to retrieve.
 		 * @param e The entity that owns the component.
-		 * @return T& Reference to the component instance.
+		 * @return ComponentRef<T> Reference to the component instance (SoARef<T> for SoA components).
 		 */
-		template<typename T> T& GetComponent(Entity e) const;
+		template<typename T> ComponentRef<T> GetComponent(Entity e) const;
+
+		/**
+		 * @brief Same as GetComponent(), read-only: the pool is not touched (see RestoreFrom()).
+		 *
+		 * @tparam T Component type to retrieve.
+		 * @param e The entity that owns the component.
+		 * @return ConstComponentRef<T> Const reference to the component instance (a copy for SoA components).
+		 */
+		template<typename T> ConstComponentRef<T> GetConstComponent(Entity e) const;
+
+		/**
+		 * @brief Same as GetComponent(), and marks the component as changed (see MarkChanged()).
+		 *
+		 * @tparam T Component type to retrieve.
+		 * @param e The entity that owns the component.
+		 * @return ComponentRef<T> Reference to the component instance.
+		 */
+		template<typename T> ComponentRef<T> GetMutableComponent(Entity e);
+
+		// Change detection
+		/**
+		 * @brief Record the ticks at which the components of type T are added, changed and removed.
+		 *
+		 * Needed by the Added<T>, Changed<T> and Removed<T> view filters. Components already in
+		 * the pool count as added and changed at tick 0. Only available in StorageMode::SparseSet,
+		 * aborts in StorageMode::Archetype.
+		 * Entity creations and kills are logged from then on too, for WriteDelta().
+		 *
+		 * @tparam T Component type.
+		 */
+		template<typename T> void EnableChangeTracking();
+
+		/**
+		 * @brief Stamp an entity's component of type T with the current tick, for Changed<T>
+		 *	(if change tracking is enabled for T), and raise an OnUpdate() event.
+		 * @tparam T Component type.
+		 * @param e The entity that owns the component.
+		 */
+		template<typename T> void MarkChanged(Entity e);
+
+		// Component observers
+		/**
+		 * @brief Listen to the construction of components of type T (AddComponent(), AddComponents()).
+		 *
+		 * Events are batched: at the end of Update(), each listener is called once with the
+		 * entities concerned since the previous Update(), in event order. Listeners can modify
+		 * the registry, the events they raise are dispatched by the next Update().
+		 *
+		 * @tparam T Component type.
+		 * @param listener Function taking (std::span<const EntityID>).
+		 */
+		template<typename T> void OnConstruct(ComponentListener listener);
+
+		/**
+		 * @brief Listen to the updates of components of type T (ReplaceComponent(), MarkChanged(),
+		 *	GetMutableComponent()). Batched like OnConstruct(), each entity listed once per batch.
+		 * @tparam T Component type.
+		 * @param listener Function taking (std::span<const EntityID>).
+		 */
+		template<typename T> void OnUpdate(ComponentListener listener);
+
+		/**
+		 * @brief Listen to the destruction of components of type T (RemoveComponent(), killed entities).
+		 *	Batched like OnConstruct(). The components are already destroyed, and the ids of
+		 *	killed entities are no longer valid.
+		 * @tparam T Component type.
+		 * @param listener Function taking (std::span<const EntityID>).
+		 */
+		template<typename T> void OnDestroy(ComponentListener listener);
+
+		/**
+		 * @brief Remove every listener of components of type T, and drop their pending events.
+		 *
+		 * @tparam T Component type.
+		 */
+		template<typename T> void ClearObservers();
+
+		/**
+		 * @brief Replace an entity's component of type T, raising an OnUpdate() event.
+		 *	Adds the component (OnConstruct()) if the entity does not have one.
+		 * @tparam T Component type.
+		 * @tparam TArgs Constructor argument types for T.
+		 * @param e The entity.
+		 * @param args Arguments forwarded to T's constructor.
+		 */
+		template<typename T, typename ...TArgs> void ReplaceComponent(Entity e, TArgs&& ...args);
+
+		/**
+		 * @brief Get the current tick, advanced by every Update().
+		 *
+		 * Changes are stamped with the current tick. Removals are kept until the end of the
+		 * Update() following them, so ViewSince<Removed<T>>(GetTick() - 1, ...) still sees the
+		 * removals of the previous frame.
+		 *
+		 * @return u32 The current tick (starts at 1).
+		 */
+		u32 GetTick() const { return m_currentTick; }
 
 		/**
 		 * @brief Check whether an Entity is currently valid (alive and matches version).
@@ -186,16 +748,52 @@ namespace ECS
 		 */
 		template<typename T> T& GetSystem() const;
 
+		/**
+		 * @brief Call System::Update() on every system, in parallel when possible.
+		 *
+		 * Systems are ordered in a dependency graph built from their read/write component
+		 * declarations (see System::ReadComponent() / System::WriteComponent()). A system
+		 * runs after every previously added system it conflicts with, systems that do not
+		 * conflict run in parallel on the registry thread pool.
+		 *
+		 * Call Update() beforehand to apply pending entity creation and destruction.
+		 *
+		 * @param deltaTime Elapsed time since the previous frame, forwarded to the systems.
+		 */
+		void RunSystems(f32 deltaTime);
+
+		// Threading
+		/**
+		 * @brief Set the thread pool used by ParallelView().
+		 *
+		 * Several registries can share the same pool.
+		 *
+		 * @param threadPool The thread pool to use.
+		 */
+		void SetThreadPool(std::shared_ptr<ThreadPool> threadPool);
+
+		/**
+		 * @brief Get the thread pool used by ParallelView().
+		 *
+		 * A pool with ThreadPool::GetDefaultWorkerCount() workers is created on first use
+		 * if none was set.
+		 *
+		 * @return ThreadPool& The thread pool.
+		 */
+		ThreadPool& GetThreadPool();
+
 		// Tag management
 		/**
 		 * @brief Assign a text tag to an entity.
 		 *
-		 * Tags provide a single-name mapping to an entity.
+		 * Tags provide a single-name mapping to an entity: tagging replaces the previous tag
+		 * of the entity, and the previous entity holding the tag loses it.
+		 * Asserts if the name hashes like another name already used as tag or group.
 		 *
 		 * @param e The entity to tag.
-		 * @param tag Null-terminated C-string tag name.
+		 * @param tag Tag name.
 		 */
-		void TagEntity(Entity e, const char* tag);
+		void TagEntity(Entity e, Name tag);
 
 		/**
 		 * @brief Check whether an entity has a specific tag.
@@ -205,7 +803,7 @@ namespace ECS
 		 * @return true If the entity has the tag.
 		 * @return false Otherwise.
 		 */
-		bool EntityHasTag(Entity e, const char* tag) const;
+		bool EntityHasTag(Entity e, Name tag) const;
 
 		/**
 		 * @brief Get the entity associated with a tag.
@@ -214,7 +812,7 @@ namespace ECS
 		 * @return Entity The entity associated with the tag. If no entity is
 		 * associated the returned Entity may be invalid.
 		 */
-		Entity GetEntityByTag(const char* tag);
+		Entity GetEntityByTag(Name tag);
 
 		/**
 		 * @brief Remove any tag assigned to an entity.
@@ -228,11 +826,12 @@ namespace ECS
 		 * @brief Add an entity to a named group.
 		 *
 		 * Groups allow multiple entities to be associated with a single name.
+		 * Asserts if the name hashes like another name already used as tag or group.
 		 *
 		 * @param e The entity to add to the group.
-		 * @param group Null-terminated C-string group name.
+		 * @param group Group name.
 		 */
-		void GroupEntity(Entity e, const char* group);
+		void GroupEntity(Entity e, Name group);
 
 		/**
 		 * @brief Query whether an entity belongs to a named group.
@@ -242,15 +841,16 @@ namespace ECS
 		 * @return true If the entity is a member of the group.
 		 * @return false Otherwise.
 		 */
-		bool EntityBelongsToGroup(Entity e, const char* group) const;
+		bool EntityBelongsToGroup(Entity e, Name group) const;
 
 		/**
 		 * @brief Retrieve all entities that belong to a named group.
 		 *
 		 * @param group Group name to lookup.
-		 * @return const std::vector<Entity>& Reference to the group's entity list.
+		 * @return std::span<const Entity> The group's entities, empty if the group does not exist.
+		 *	Invalidated by any group change.
 		 */
-		const std::vector<Entity>& GetEntitiesByGroup(const char* group);
+		std::span<const Entity> GetEntitiesByGroup(Name group) const;
 
 		/**
 		 * @brief Remove an entity from all groups it belongs to.
@@ -260,141 +860,952 @@ namespace ECS
 		void RemoveEntityGroup(Entity e);
 
 	private:
+		// Debug record of the string of a tag or group name, asserting if another string has the same hash
+		void RegisterName(Name name);
+		// Debug check that a looked up name does not collide with a registered one
+		void CheckName(Name name) const;
+		// Index of a group in m_groups, u32_invalid_id if it does not exist
+		u32 FindGroup(u32 hash) const;
+		template<typename... Components> friend class Query;
+
+		void PlaybackCommandBuffers();
 		void AddEntityToSystems(Entity e);
+		void UpdateSystemMembership();
+		void BuildSystemIndex();
+
+		// Update the entity signature and the queries using the component
+		void OnComponentAdded(EntityID entityId, u32 componentId);
+		void OnComponentRemoved(EntityID entityId, u32 componentId);
+		void TrackSignatureChange(EntityID entityId, const Signature& previous);
+
+		// Entity blocks of a snapshot (see Snapshot.cpp)
+		void SaveSnapshotEntities(SnapshotWriter& writer, u32 poolCount) const;
+		static bool ReadSnapshotEntities(SnapshotReader& reader, SnapshotEntities& entities);
+		void LoadSnapshotEntities(const SnapshotEntities& entities);
+
+		// Entity records of a delta (see Delta.cpp)
+		void WriteDeltaEntities(DeltaWriter& writer, u32 sinceTick, u32 poolCount) const;
+		bool ApplyDeltaEntities(DeltaReader& reader, const DeltaHeader& header);
+		// Make an entity id of another registry alive here, with the same index and version.
+		// Leaves the free list to be rebuilt by the caller
+		void AdoptEntity(EntityID entityId);
+
+		// Entity slots (see m_entitySlots)
+		bool IsSlotAlive(u32 index) const { return GetEntityIndex(m_entitySlots[index]) == index; }
+		// Grow the per-entity arrays to hold at least count entities, geometrically or exactly
+		void GrowEntities(size_t count);
+		void ResizeEntities(size_t count);
+		// Push or pop the head of the free list, popping makes the slot alive
+		void PushFreeIndex(u32 index, u32 version);
+		u32 PopFreeIndex();
+		// Bump the version of a killed entity index and free it, or retire it (see SetVersionOverflow())
+		void ReleaseEntityIndex(u32 index);
+		// Remove a valid entity from its systems, queries, tags and archetype, queue its pool removals
+		// and release its index (see Update())
+		void DestroyEntity(Entity e);
+		// Run the pool removals queued by DestroyEntity(), one batch per pool
+		void FlushPoolRemovals();
+
+		enum class ComponentEvent { Construct, Update, Destroy, Count };
+		void QueueComponentEvent(ComponentEvent event, u32 componentId, EntityID entityId);
+		void DispatchComponentEvents();
+		template<typename T> void AddComponentListener(ComponentEvent event, ComponentListener listener);
+		void RemoveEntityFromQueries(EntityID entityId);
 		void RemoveEntityFromSystems(Entity e);
+		void BuildSystemGraph();
+
+		template<typename... Components, typename Runner, typename Func> void RunView(Runner&& runner, Func& func, u32 tick);
+		template<typename... Components, typename Runner, typename Func, typename... Required>
+		void RunPoolView(Runner&& runner, Func& func, u32 tick, std::tuple<Required...>*);
+#if ECS_ENABLE_PROFILING
+		// Time run(countingFunc) as a view event with the number of entities passed to func
+		template<typename... Components, typename Func, typename Run> void ProfileView(Func& func, Run&& run);
+#endif
+		// Report a misuse that only shows at runtime and abort, in every build
+		[[noreturn]] static void Fatal(const char* message);
+
+		template<typename Filter, typename PoolType> static bool PassesViewFilter(const PoolType& pool, u32 packedIndex, u32 tick);
+		// Pool of a view term, const for a read-only term so that its accessors do not touch it
+		template<typename Term, typename PoolType> static auto& ViewPool(PoolType* pool);
+		template<typename... Components, typename Runner, typename Func, typename... Required>
+		void RunArchetypeView(Runner&& runner, Func& func, std::tuple<Required...>*);
+
+		template<typename... Components, typename Func> void ForEachPoolChunk(Func& func);
+		// ForEachPoolChunk() over pools that are not side by side, through scratch arrays
+		template<typename T> using ChunkScratch = std::vector<T, AlignedAllocator<T, CACHE_LINE_SIZE>>;
+		template<typename... Components, typename Func, typename Pools> void ForEachGatheredChunk(Func& func, const Pools& pools);
+		template<typename... Components> Signature MakeSignature();
+
+		// Registry component id of a type (see GetComponentId()), handed out on first use
+		template<typename T> u32 AssignComponentId() { return AssignComponentId(Component<T>::GetId()); }
+		u32 AssignComponentId(u64 typeId);
+
+		// Map the component types declared by a system to the registry component ids
+		void BindSystem(System& system);
 
 		template<typename T> Pool<T>* GetPool() const;
+		template<typename T> Pool<T>* GetOrCreatePool();
 
 	private:
+		// Timings and counters, filled when built with ECS_ENABLE_PROFILING
+		Profiler m_profiler;
+
+		// Memory of the pools and of the per-entity containers below, see Registry()
+		std::pmr::memory_resource* m_memoryResource;
+		// Sparse pages of the pools, owned when the registry has its own memory resource
+		std::unique_ptr<PageAllocator> m_ownedPageAllocator;
+		PageAllocator* m_pageAllocator;
+
+		StorageMode m_storageMode = StorageMode::SparseSet;
+
+		// [vector index = Component<T>::GetId()] registry component id, u32_invalid_id if the type is not used
+		std::vector<u32> m_componentIds;
+		u32 m_componentCount = 0;
+
+		// Change detection tick, see GetTick()
+		u32 m_currentTick = 1;
+
 		int m_numEntities = 0;
-		std::set<Entity> m_entitiesToBeAdded; // Entities awaiting creation in the next Registry Update()
-		std::set<Entity> m_entitiesToBeKilled; // Entities awaiting destruction in the next Registry Update()
+		std::pmr::vector<Entity> m_entitiesToBeAdded{ m_memoryResource }; // Entities awaiting creation in the next Registry Update()
+		std::pmr::vector<Entity> m_entitiesToBeKilled{ m_memoryResource }; // Entities awaiting destruction in the next Registry Update()
 
 		// Vector of component pools.
 		// Each pool contains all the data for a specific component type
 		// [vector index = componentId], [pool index = entity Id]
-		std::vector<std::unique_ptr<IPool>> m_componentPools;
+		std::pmr::vector<ResourcePtr<IPool>> m_componentPools{ m_memoryResource };
+
+		// Entities to remove from each pool during Update(), kept to reuse the allocations
+		// [vector index = componentId]
+		std::pmr::vector<std::pmr::vector<EntityID>> m_pendingPoolRemovals{ m_memoryResource };
+
+		// Component storage in StorageMode::Archetype (m_componentPools stays empty)
+		ResourcePtr<ArchetypeStorage> m_archetypes;
+
+		// Owning groups declared with OwnGroup() (must be destroyed before the pools they own)
+		std::vector<std::unique_ptr<OwningGroup>> m_owningGroups;
 
 		// Vector of component signatures.
 		// The signature lets us know which components are turned "on" for an entity
 		// [vector index = entity Id]
-		std::vector<Signature> m_entityComponentSignatures;
+		std::pmr::vector<Signature> m_entityComponentSignatures{ m_memoryResource };
+
+		// Persistent queries, and the queries using each component [vector index = componentId]
+		std::vector<std::unique_ptr<QueryState>> m_queries;
+		std::vector<std::vector<QueryState*>> m_queriesByComponent;
+
+		// Command buffers, played back in this order by Update()
+		std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
+		std::vector<Entity> m_playbackEntities; // Entities created by the playback, kept to reuse the allocation
+
+		// Component observers [vector index = componentId]
+		struct ComponentObservers
+		{
+			std::vector<ComponentListener> listeners[(size_t)ComponentEvent::Count];
+			std::vector<EntityID> pending[(size_t)ComponentEvent::Count]; // Events since the last dispatch
+			std::vector<EntityID> dispatching[(size_t)ComponentEvent::Count]; // Batch being dispatched, kept to reuse the allocations
+		};
+		std::vector<ComponentObservers> m_observers;
 
 		// Map of active systems [index = system typeid]
 		std::unordered_map<std::type_index, std::shared_ptr<System>> m_systems;
+		// Active systems in the order they were added
+		std::vector<std::shared_ptr<System>> m_systemOrder;
+
+		// Dependency graph of m_systemOrder, rebuilt by RunSystems() when systems changed
+		struct SystemNode
+		{
+			std::vector<u32> dependents; // Systems that must wait for this one
+			u32 dependencyCount = 0; // Systems this one must wait for
+		};
+		std::vector<SystemNode> m_systemGraph;
+		bool m_systemGraphDirty = false;
+
+		// Systems requiring each component, rebuilt by Update() when systems changed [vector index = componentId]
+		std::vector<std::vector<System*>> m_systemsByComponent;
+		// Systems requiring no component, every entity is in them
+		std::vector<System*> m_systemsWithoutComponents;
+		bool m_systemIndexDirty = false;
+
+		// Live entities whose signature changed since the systems last saw them,
+		// with the signature the systems saw
+		struct SignatureChange
+		{
+			EntityID entityId;
+			Signature previous;
+		};
+		std::pmr::vector<SignatureChange> m_signatureChanges{ m_memoryResource };
+
+		// Entity creations and kills in tick order, logged once change tracking is enabled (see WriteDelta())
+		struct EntityLogEntry
+		{
+			EntityID entityId;
+			u32 tick;
+		};
+		bool m_entityLogEnabled = false;
+		std::pmr::vector<EntityLogEntry> m_createdEntityLog{ m_memoryResource };
+		std::pmr::vector<EntityLogEntry> m_killedEntityLog{ m_memoryResource };
+
+		// [vector index = entity index] true while the systems are to be updated for the entity
+		// in the next Update() (newly created, or listed in m_signatureChanges)
+		std::pmr::vector<bool> m_systemSyncPending{ std::pmr::polymorphic_allocator<bool>(m_memoryResource) };
 
-		// List of free ids that were previously removed
-		std::deque<u32> m_freeIndices;
+		// Workers used by ParallelView (lazily created)
+		std::shared_ptr<ThreadPool> m_threadPool;
 
-		// Actual version of each entity (used to check if an entity is still valid after being killed and its ID reused)
-		std::vector<u32> m_entityVersions;
+		// [vector index = entity index] id of the alive entity, checked by IsValid() (a killed entity id can be reused with a newer version).
+		// A slot that is not alive holds another index: its free slots form an implicit LIFO free list, each one holding
+		// the version its next entity gets and the index of the next free slot. Slots past m_numEntities are never-used
+		// indices, retired indices (see SetVersionOverflow()) hold u32_invalid_id as version.
+		std::pmr::vector<EntityID> m_entitySlots{ m_memoryResource };
+		u32 m_freeHead = u32_invalid_id; // Last freed index, reused first, u32_invalid_id if none
+		u32 m_freeCount = 0;
+
+		VersionOverflow m_versionOverflow = VersionOverflow::Wrap;
+		u32 m_maxEntityVersion = MAX_ENTITY_VERSION;
 
 		// Entity tags (one tag name per entity)
 		// Index = EntityID, Value = TagHash
-		std::vector<u32> m_entityToTag;
+		std::pmr::vector<u32> m_entityToTag{ m_memoryResource };
 		// Key = TagHash, Value = EntityID
-		std::unordered_map<u32, EntityID> m_tagToEntity;
+		std::pmr::unordered_map<u32, EntityID> m_tagToEntity{ m_memoryResource };
 
-		// Entity groups (a set of entities per group name)
+		// Entity groups, stored like a Pool: packed entities and a sparse entity index -> packed index
 		struct GroupData
 		{
-			std::vector<Entity> entities;
-			std::unordered_map<EntityID, int> entityToIndex;
+			GroupData(PageAllocator& allocator, std::pmr::memory_resource* resource) : entities(resource), sparse(PAGE_SIZE, allocator) {}
+
+			std::pmr::vector<Entity> entities;
+			SparseIndex sparse;
 		};
-		std::unordered_map<u32, GroupData> m_groups;
-		// ID -> Groups
-		std::vector<std::vector<u32>> m_entityGroups;
+		std::pmr::vector<ResourcePtr<GroupData>> m_groups{ m_memoryResource };
+		// (Hash, index in m_groups), sorted by hash. Few groups: a sorted vector beats a node-based map
+		std::vector<std::pair<u32, u32>> m_groupLookup;
+
+		// Hash -> string of every tag and group name, to detect collisions (filled in debug builds only)
+		std::unordered_map<u32, std::string> m_names;
 	};
 
 	template<typename... Components, typename Func>
 	void Registry::View(Func&& func)
+	{
+		ViewSince<Components...>(m_currentTick, std::forward<Func>(func));
+	}
+
+	template<typename... Components, typename Func>
+	void Registry::ViewSince(u32 tick, Func&& func)
+	{
+		auto runner = [](size_t count, auto&& chunk) { chunk((size_t)0, count); };
+#if ECS_ENABLE_PROFILING
+		ProfileView<Components...>(func, [&](auto& profiled) { RunView<Components...>(runner, profiled, tick); });
+#else
+		RunView<Components...>(runner, func, tick);
+#endif
+	}
+
+	template<typename... Components, typename Func>
+	void Registry::ParallelView(Func&& func, size_t grainSize)
+	{
+		ThreadPool& threadPool = GetThreadPool();
+		auto runner = [&threadPool, grainSize](size_t count, auto&& chunk) {
+			threadPool.ParallelFor(count, grainSize, chunk);
+			};
+#if ECS_ENABLE_PROFILING
+		ProfileView<Components...>(func, [&](auto& profiled) { RunView<Components...>(runner, profiled, m_currentTick); });
+#else
+		RunView<Components...>(runner, func, m_currentTick);
+#endif
+	}
+
+#if ECS_ENABLE_PROFILING
+	template<typename... Components, typename Func, typename Run>
+	void Registry::ProfileView(Func& func, Run&& run)
+	{
+		// "View<Position, Velocity>", built once per view type
+		static const std::string name = []() {
+			std::string result = "View<";
+			((result += GetTypeName<Components>(), result += ", "), ...);
+			result.resize(result.size() - 2);
+			return result + ">";
+			}();
+
+		std::atomic<u32> processed = 0;
+		auto counted = [&func, &processed](auto&&... args) {
+			processed.fetch_add(1, std::memory_order_relaxed);
+			func(std::forward<decltype(args)>(args)...);
+			};
+
+		ProfileScope scope(m_profiler, name);
+		run(counted);
+		scope.SetEntityCount(processed.load(std::memory_order_relaxed));
+	}
+#endif
+
+	template<typename Filter, typename PoolType>
+	bool Registry::PassesViewFilter(const PoolType& pool, u32 packedIndex, u32 tick)
+	{
+		if constexpr (ViewFilter<Filter>::kind == ViewFilterKind::Added)
+			return pool.GetChangeTracker()->GetAddedTick(packedIndex) >= tick;
+		else if constexpr (ViewFilter<Filter>::kind == ViewFilterKind::Changed)
+			return pool.GetChangeTracker()->GetChangedTick(packedIndex) >= tick;
+		else
+			return true;
+	}
+
+	template<typename Term, typename PoolType>
+	auto& Registry::ViewPool(PoolType* pool)
+	{
+		if constexpr (IsReadOnlyViewTerm<Term>)
+			return std::as_const(*pool);
+		else
+			return *pool;
+	}
+
+	template<typename... Components, typename Runner, typename Func>
+	void Registry::RunView(Runner&& runner, Func& func, u32 tick)
+	{
+		// The ticks are kept by the pools, an archetype view would silently visit nothing
+		if constexpr (((IsViewFilter<Components>) || ...))
+		{
+			if (m_archetypes)
+				Fatal("Added<T>, Changed<T> and Removed<T> views need StorageMode::SparseSet");
+		}
+
+		if constexpr (((ViewFilter<Components>::kind == ViewFilterKind::Removed) || ...))
+		{
+			static_assert(sizeof...(Components) == 1, "Removed<T> can only be viewed alone");
+
+			// Removed components are not in the pool anymore, walk the removal log instead
+			Pool<FilteredComponent<Components>...>* pool = GetPool<FilteredComponent<Components>...>();
+			if (!pool)
+				return;
+
+			assert(pool->GetChangeTracker() && "Removed<T> needs EnableChangeTracking<T>()");
+			std::span<const ChangeTracker::Removal> removals = pool->GetChangeTracker()->GetRemovals(tick);
+			runner(removals.size(), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					func(removals[i].entityId);
+				});
+			return;
+		}
+		else
+		{
+			if (m_archetypes)
+			{
+				if constexpr (!((IsViewFilter<Components>) || ...))
+					RunArchetypeView<Components...>(runner, func, (RequiredViewTerms<Components...>*)nullptr);
+				return;
+			}
+
+			RunPoolView<Components...>(runner, func, tick, (RequiredViewTerms<Components...>*)nullptr);
+		}
+	}
+
+	template<typename... Components, typename Runner, typename Func, typename... Required>
+	void Registry::RunPoolView(Runner&& runner, Func& func, u32 tick, std::tuple<Required...>*)
+	{
+		static_assert(sizeof...(Required) > 0, "A view needs at least one component that is not Exclude<> or Optional<>");
+
+		if ((!GetPool<FilteredComponent<Required>>() || ...))
+			return;
+
+		auto pools = std::make_tuple(GetPool<FilteredComponent<Required>>()...);
+		assert(((!IsViewFilter<Required> || std::get<Pool<FilteredComponent<Required>>*>(pools)->GetChangeTracker()) && ...) &&
+			"Added<T>/Changed<T> need EnableChangeTracking<T>()");
+
+		auto optionalPools = std::tuple_cat(ViewModifier<Components>::GetPools([this]<typename T>() { return GetPool<T>(); })...);
+
+		// Membership is tested on the entity signature, one mask test instead of a sparse probe per pool
+		Signature required;
+		(required.set(GetComponentId<FilteredComponent<Required>>()), ...);
+
+		Signature excluded;
+		auto exclude = [this, &excluded]<typename T>() {
+			const u32 componentId = GetComponentId<T>();
+			if (componentId != u32_invalid_id)
+				excluded.set(componentId);
+			};
+		([&exclude]() {
+			if constexpr (ViewModifier<Components>::exclude)
+				ViewModifier<Components>::ForEachType(exclude);
+			}(), ...);
+
+		// Arguments of func for one view argument, in the declared order.
+		// Aligned: the entity is at packedIndex in every required pool, no sparse lookup needed
+		auto args = [&pools, &optionalPools]<typename Term, bool Aligned>(EntityID entityId, size_t packedIndex) {
+			if constexpr (ViewModifier<Term>::optional)
+				return ViewModifier<Term>::GetArgs(optionalPools, entityId);
+			else if constexpr (ViewModifier<Term>::exclude)
+				return std::tuple<>();
+			else
+			{
+				auto* pool = std::get<Pool<FilteredComponent<Term>>*>(pools);
+				if constexpr (Aligned)
+					return std::tuple<decltype(ViewPool<Term>(pool)[0u])>(ViewPool<Term>(pool)[(unsigned int)packedIndex]);
+				else
+					return std::tuple<decltype(ViewPool<Term>(pool).Get(entityId))>(ViewPool<Term>(pool).Get(entityId));
+			}
+			};
+		auto call = [&func, &args, &pools]<bool Aligned>(EntityID entityId, size_t packedIndex) {
+			if constexpr (((IsViewModifier<Components>) || ...))
+				std::apply(func, std::tuple_cat(std::tuple<EntityID>(entityId), args.template operator()<Components, Aligned>(entityId, packedIndex)...));
+			else if constexpr (Aligned)
+				func(entityId, ViewPool<Components>(std::get<Pool<FilteredComponent<Components>>*>(pools))[(unsigned int)packedIndex]...);
+			else
+				func(entityId, ViewPool<Components>(std::get<Pool<FilteredComponent<Components>>*>(pools)).Get(entityId)...);
+			};
+
+		// Fast path: the required components are exactly the ones of an owning group
+		OwningGroup* group = std::get<0>(pools)->GetOwningGroup();
+		if (group && group->GetPools().size() == sizeof...(Required) &&
+			((std::get<Pool<FilteredComponent<Required>>*>(pools)->GetOwningGroup() == group) && ...))
+		{
+			const std::pmr::vector<EntityID>& entities = std::get<0>(pools)->GetEntities();
+			runner(group->GetSize(), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					if (excluded.any() && m_entityComponentSignatures[GetEntityIndex(entities[i])].Intersects(excluded))
+						continue;
+
+					if ((PassesViewFilter<Required>(*std::get<Pool<FilteredComponent<Required>>*>(pools), (u32)i, tick) && ...))
+						call.template operator()<true>(entities[i], i);
+				}
+				});
+			return;
+		}
+
+		// A single pool is walked in packed order, only the exclusions need the signature
+		if constexpr (sizeof...(Required) == 1)
+		{
+			const std::pmr::vector<EntityID>& entities = std::get<0>(pools)->GetEntities();
+			runner(entities.size(), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					if (excluded.any() && m_entityComponentSignatures[GetEntityIndex(entities[i])].Intersects(excluded))
+						continue;
+
+					if ((PassesViewFilter<Required>(*std::get<Pool<FilteredComponent<Required>>*>(pools), (u32)i, tick) && ...))
+						call.template operator()<true>(entities[i], i);
+				}
+				});
+			return;
+		}
+
+		// Pick the smallest pool as the leader, the others are only probed
+		const std::pmr::vector<EntityID>* leaderEntities = nullptr;
+		std::apply([&leaderEntities](auto*... p) {
+			auto pick = [&leaderEntities](const std::pmr::vector<EntityID>& entities) {
+				if (!leaderEntities || entities.size() < leaderEntities->size())
+					leaderEntities = &entities;
+				};
+			(pick(p->GetEntities()), ...);
+			}, pools);
+
+		runner(leaderEntities->size(), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				EntityID entityId = (*leaderEntities)[i];
+
+				const Signature& signature = m_entityComponentSignatures[GetEntityIndex(entityId)];
+				if (!signature.Contains(required) || signature.Intersects(excluded))
+					continue;
+
+				// Then the change filters, on the packed slot of the filtered components only
+				if ((PassesViewFilter<Required>(*std::get<Pool<FilteredComponent<Required>>*>(pools),
+					IsViewFilter<Required> ? (u32)std::get<Pool<FilteredComponent<Required>>*>(pools)->GetPackedIndex(entityId) : 0, tick) && ...))
+					call.template operator()<false>(entityId, i);
+			}
+			});
+	}
+
+	template<typename... Components, typename Runner, typename Func, typename... Required>
+	void Registry::RunArchetypeView(Runner&& runner, Func& func, std::tuple<Required...>*)
+	{
+		static_assert(sizeof...(Required) > 0, "A view needs at least one component that is not Exclude<> or Optional<>");
+
+		// Exclude<> is a second mask on the archetype signatures, tested once per archetype
+		Signature excluded;
+		auto exclude = [this, &excluded]<typename T>() {
+			const u32 componentId = GetComponentId<T>();
+			if (componentId != u32_invalid_id)
+				excluded.set(componentId);
+			};
+		([&exclude]() {
+			if constexpr (ViewModifier<Components>::exclude)
+				ViewModifier<Components>::ForEachType(exclude);
+			}(), ...);
+
+		m_archetypes->ForEachArchetype(MakeSignature<FilteredComponent<Required>...>(), excluded, [&](const Archetype& archetype) {
+			const size_t capacity = archetype.GetChunkCapacity();
+
+			// Columns of one view argument in a chunk, Optional<> ones are nullptr when the archetype does not have them
+			auto termColumns = [this, &archetype]<typename Term>(size_t chunk) {
+				if constexpr (ViewModifier<Term>::optional)
+				{
+					return ViewModifier<Term>::GetColumns([this, &archetype, chunk]<typename T>() -> T* {
+						const u32 componentId = GetComponentId<T>();
+						const int column = componentId == u32_invalid_id ? -1 : archetype.GetColumn(componentId);
+						return column == -1 ? nullptr : static_cast<T*>(archetype.GetColumnData(chunk, column));
+						});
+				}
+				else if constexpr (ViewModifier<Term>::exclude)
+					return std::tuple<>();
+				else
+					return std::tuple<Term*>(static_cast<Term*>(archetype.GetColumnData(chunk, archetype.GetColumn(GetComponentId<FilteredComponent<Term>>()))));
+				};
+			// Arguments of func for one view argument at row i of the chunk
+			auto args = []<typename Term, typename Columns>(const Columns& columns, size_t i) {
+				if constexpr (ViewModifier<Term>::optional)
+					return std::apply([i](auto*... column) { return std::make_tuple((column ? column + i : nullptr)...); }, columns);
+				else if constexpr (ViewModifier<Term>::exclude)
+					return std::tuple<>();
+				else
+					return std::tuple<ComponentRef<Term>>(std::get<0>(columns)[i]);
+				};
+
+			runner(archetype.GetEntityCount(), [&](size_t begin, size_t end) {
+				// Walk the range chunk by chunk, each column being a plain array inside a chunk
+				while (begin < end)
+				{
+					const size_t chunk = begin / capacity;
+					const size_t first = begin % capacity;
+					const size_t last = std::min(capacity, first + (end - begin));
+
+					const EntityID* entities = archetype.GetChunkEntities(chunk);
+					auto columns = std::make_tuple(termColumns.template operator()<Components>(chunk)...);
+
+					std::apply([&](const auto&... chunkColumns) {
+						for (size_t i = first; i < last; ++i)
+						{
+							if constexpr (((IsViewModifier<Components>) || ...))
+								std::apply(func, std::tuple_cat(std::tuple<EntityID>(entities[i]), args.template operator()<Components>(chunkColumns, i)...));
+							else
+								func(entities[i], ComponentRef<Components>(std::get<0>(chunkColumns)[i])...);
+						}
+						}, columns);
+
+					begin += last - first;
+				}
+				});
+			});
+	}
+
+	template<typename... Components, typename Func>
+	void Registry::ForEachChunk(Func&& func)
+	{
+		if (m_archetypes)
+		{
+			m_archetypes->ForEachArchetype(MakeSignature<Components...>(), [&](const Archetype& archetype) {
+				for (size_t chunk = 0; chunk < archetype.GetChunkCount(); ++chunk)
+				{
+					const size_t count = archetype.GetChunkEntityCount(chunk);
+					func(std::span<const EntityID>(archetype.GetChunkEntities(chunk), count),
+						std::span<Components>(static_cast<Components*>(archetype.GetColumnData(chunk, archetype.GetColumn(GetComponentId<Components>()))), count)...);
+				}
+				});
+			return;
+		}
+
+		// The storage mode is only known at runtime, hence not a static_assert
+		if constexpr ((SoAComponent<Components> || ...))
+			Fatal("SoA components are split in field arrays in StorageMode::SparseSet, use ForEachField");
+		else
+		{
+			ForEachPoolChunk<Components...>(func);
+		}
+	}
+
+	template<typename... Components, typename Func>
+	void Registry::ForEachPoolChunk(Func& func)
 	{
 		if ((!GetPool<Components>() || ...))
 			return;
 
 		auto pools = std::make_tuple(GetPool<Components>()...);
+		size_t count = std::get<0>(pools)->GetSize();
 
-		using FirstType = std::tuple_element_t<0, std::tuple<Components...>>;
-		auto* leaderPool = std::get<0>(pools);
+		if constexpr (sizeof...(Components) > 1)
+		{
+			OwningGroup* group = std::get<0>(pools)->GetOwningGroup();
+			const bool grouped = group && group->GetPools().size() == sizeof...(Components) &&
+				((std::get<Pool<Components>*>(pools)->GetOwningGroup() == group) && ...);
+			if (!grouped)
+			{
+				ForEachGatheredChunk<Components...>(func, pools);
+				return;
+			}
+
+			count = group->GetSize();
+		}
 
-		const std::vector<EntityID>& entities = leaderPool->GetEntities();
+		// Batch starts are multiples of CHUNK_BATCH_SIZE, so every span stays aligned
+		const std::pmr::vector<EntityID>& entities = std::get<0>(pools)->GetEntities();
+		for (size_t begin = 0; begin < count; begin += CHUNK_BATCH_SIZE)
+		{
+			const size_t length = std::min(CHUNK_BATCH_SIZE, count - begin);
+			auto batch = [begin, length]<typename T>(Pool<T>* pool) {
+				if constexpr (EmptyComponent<T>)
+					return Pool<T>::GetInstances(length);
+				else
+					return std::span<T>(pool->GetData().data() + begin, length);
+				};
+			func(std::span<const EntityID>(entities.data() + begin, length), batch(std::get<Pool<Components>*>(pools))...);
+		}
+	}
 
-		for (EntityID entityId : entities)
+	template<typename... Components, typename Func, typename Pools>
+	void Registry::ForEachGatheredChunk(Func& func, const Pools& pools)
+	{
+		Signature required;
+		(required.set(GetComponentId<Components>()), ...);
+
+		// The smallest pool leads, the others are tested on the entity signature
+		const std::pmr::vector<EntityID>* leaderEntities = nullptr;
+		std::apply([&leaderEntities](auto*... p) {
+			auto pick = [&leaderEntities](const std::pmr::vector<EntityID>& entities) {
+				if (!leaderEntities || entities.size() < leaderEntities->size())
+					leaderEntities = &entities;
+				};
+			(pick(p->GetEntities()), ...);
+			}, pools);
+
+		std::pmr::vector<EntityID> entities(m_memoryResource);
+		entities.reserve(std::min(CHUNK_BATCH_SIZE, leaderEntities->size()));
+		auto scratch = std::make_tuple(ChunkScratch<Components>(AlignedAllocator<Components, CACHE_LINE_SIZE>(m_memoryResource))...);
+
+		auto flush = [&]() {
+			func(std::span<const EntityID>(entities.data(), entities.size()), std::span<Components>(std::get<ChunkScratch<Components>>(scratch))...);
+
+			// func may have written to the batch, move it back
+			for (size_t i = 0; i < entities.size(); ++i)
+				((std::get<Pool<Components>*>(pools)->Get(entities[i]) = std::move(std::get<ChunkScratch<Components>>(scratch)[i])), ...);
+
+			entities.clear();
+			(std::get<ChunkScratch<Components>>(scratch).clear(), ...);
+			};
+
+		for (EntityID entityId : *leaderEntities)
 		{
-			// Fold expression to check if the entity has all required components
-			bool hasAll = std::apply([entityId](auto*... p) {
-				return (... && p->Has(entityId));
-				}, pools);
+			if (!m_entityComponentSignatures[GetEntityIndex(entityId)].Contains(required))
+				continue;
+
+			entities.push_back(entityId);
+			(std::get<ChunkScratch<Components>>(scratch).push_back(std::as_const(*std::get<Pool<Components>*>(pools)).Get(entityId)), ...);
+			if (entities.size() == CHUNK_BATCH_SIZE)
+				flush();
+		}
+
+		if (!entities.empty())
+			flush();
+	}
+
+	template<typename T, auto... Members, typename Func>
+	void Registry::ForEachField(Func&& func)
+	{
+		static_assert(SoAComponent<T>, "ForEachField needs a component with an SoALayout");
+		assert(!m_archetypes && "ForEachField needs StorageMode::SparseSet");
 
-			if (hasAll)
-				func(entityId, std::get<Pool<Components>*>(pools)->Get(entityId)...);
+		Pool<T>* pool = GetPool<T>();
+		if (!pool)
+			return;
+
+		const size_t count = pool->GetSize();
+		const std::pmr::vector<EntityID>& entities = pool->GetEntities();
+		for (size_t begin = 0; begin < count; begin += CHUNK_BATCH_SIZE)
+		{
+			const size_t length = std::min(CHUNK_BATCH_SIZE, count - begin);
+			func(std::span<const EntityID>(entities.data() + begin, length),
+				std::span(pool->template GetField<Members>().data() + begin, length)...);
+		}
+	}
+
+	template<typename... Owned>
+	OwningGroup& Registry::OwnGroup()
+	{
+		static_assert(sizeof...(Owned) >= 2, "An owning group needs at least two component types");
+		assert(!m_archetypes && "Owning groups need StorageMode::SparseSet");
+
+		std::vector<IPool*> pools = { GetOrCreatePool<Owned>()... };
+
+		if (OwningGroup* existing = pools[0]->GetOwningGroup())
+		{
+			if (existing->GetPools().size() == pools.size() &&
+				std::all_of(pools.begin(), pools.end(), [existing](IPool* pool) { return pool->GetOwningGroup() == existing; }))
+				return *existing;
+		}
+
+		m_owningGroups.emplace_back(std::make_unique<OwningGroup>(std::move(pools)));
+		return *m_owningGroups.back();
+	}
+
+	template<typename... Components>
+	Query<Components...> Registry::CreateQuery()
+	{
+		const Signature signature = MakeSignature<Components...>();
+
+		for (const auto& query : m_queries)
+		{
+			if (query->GetSignature() == signature)
+				return Query<Components...>(*this, *query);
+		}
+
+		QueryState& query = *m_queries.emplace_back(std::make_unique<QueryState>(signature));
+		signature.ForEachSetBit([this, &query](u32 componentId) {
+			if (componentId >= m_queriesByComponent.size())
+				m_queriesByComponent.resize(componentId + 1);
+			m_queriesByComponent[componentId].push_back(&query);
+			});
+
+		// Initial population, slots that are not alive have an empty signature
+		for (u32 index = 0; index < (u32)m_numEntities; ++index)
+		{
+			if (m_entityComponentSignatures[index].Contains(signature))
+				query.Add(m_entitySlots[index]);
 		}
 
+		return Query<Components...>(*this, query);
 	}
 
 	template<typename T, typename ...TArgs>
 	void Registry::AddComponent(Entity e, TArgs&& ...args)
 	{
-		const auto componentId = Component<T>::GetId();
+		const u32 componentId = AssignComponentId<T>();
 		const auto entityId = e.GetId();
 
-		if (componentId >= m_componentPools.size())
-			m_componentPools.resize(componentId + 1);
+		if (m_archetypes)
+		{
+			m_archetypes->Add<T>(entityId, componentId, T(std::forward<TArgs>(args)...));
+		}
+		else
+		{
+			// Get the pool of component values for that component type
+			auto* pool = GetOrCreatePool<T>();
+			pool->Add(entityId, T(std::forward<TArgs>(args)...));
+		}
 
-		// If we still don't have a Pool for that component type
-		if (!m_componentPools[componentId])
-			m_componentPools[componentId] = std::make_unique<Pool<T>>();
+		OnComponentAdded(entityId, (u32)componentId);
+	}
 
-		// Get the pool of component values for that component type
-		auto* pool = static_cast<Pool<T>*>(m_componentPools[componentId].get());
-		pool->Add(entityId, T(std::forward<TArgs>(args)...));
+	template<typename T>
+	void Registry::AddComponents(std::span<const Entity> entities, std::span<const T> values)
+	{
+		assert(entities.size() == values.size() && "One component value is needed per entity");
+
+		const u32 componentId = AssignComponentId<T>();
+
+		if (m_archetypes)
+		{
+			for (size_t i = 0; i < entities.size(); ++i)
+			{
+				const auto entityId = entities[i].GetId();
+				m_archetypes->Add<T>(entityId, componentId, T(values[i]));
+				OnComponentAdded(entityId, (u32)componentId);
+			}
+			return;
+		}
 
-		m_entityComponentSignatures[entityId].set(componentId);
+		auto* pool = GetOrCreatePool<T>();
+		pool->Reserve(pool->GetSize() + entities.size());
 
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			const auto entityId = entities[i].GetId();
+			pool->Add(entityId, values[i]);
+			OnComponentAdded(entityId, (u32)componentId);
+		}
 	}
 
 	template<typename T>
 	void Registry::RemoveComponent(Entity e)
 	{
-		const auto componentId = Component<T>::GetId();
+		const u32 componentId = GetComponentId<T>();
 		const auto entityId = e.GetId();
+		if (componentId == u32_invalid_id)
+			return;
 
-		m_componentPools[componentId]->RemoveEntityFromPool(entityId);
+		if (m_archetypes)
+			m_archetypes->Remove(entityId, componentId);
+		else if (componentId < m_componentPools.size() && m_componentPools[componentId])
+			m_componentPools[componentId]->RemoveEntityFromPool(entityId);
 
-		m_entityComponentSignatures[entityId].set(componentId, false);
+		OnComponentRemoved(entityId, (u32)componentId);
+	}
+
+	template<typename T>
+	void Registry::ReserveComponents(size_t count)
+	{
+		if (m_archetypes)
+			return;
+
+		auto* pool = GetOrCreatePool<T>();
+		pool->Reserve(pool->GetSize() + count);
+	}
+
+	template<typename... Components>
+	void Registry::Reserve(size_t entityCount, const std::array<size_t, sizeof...(Components)>& componentCounts)
+	{
+		Reserve(entityCount);
+		if (m_archetypes)
+			return;
+
+		size_t i = 0;
+		(GetOrCreatePool<Components>()->Reserve(componentCounts[i++]), ...);
+	}
+
+	template<typename T>
+	void Registry::SetPoolPageSize(u32 pageSize)
+	{
+		assert(!m_archetypes && "Pool page sizes need StorageMode::SparseSet");
+		GetOrCreatePool<T>()->SetPageSize(pageSize);
+	}
+
+	template<typename T>
+	ComponentRef<T> Registry::GetMutableComponent(Entity e)
+	{
+		MarkChanged<T>(e);
+		return GetComponent<T>(e);
+	}
+
+	template<typename T>
+	void Registry::EnableChangeTracking()
+	{
+		if (m_archetypes)
+			Fatal("Change tracking needs StorageMode::SparseSet");
+		GetOrCreatePool<T>()->EnableChangeTracking(m_currentTick);
+		m_entityLogEnabled = true;
+	}
+
+	template<typename T>
+	void Registry::MarkChanged(Entity e)
+	{
+		// No tick stamped nor event raised for an entity without the component
+		if (m_archetypes)
+		{
+			assert(HasComponent<T>(e) && "Entity does not have the component");
+			if (!HasComponent<T>(e))
+				return;
+		}
+		else
+		{
+			Pool<T>* pool = GetPool<T>();
+			if (!pool || !pool->MarkChanged(e.GetId()))
+				return;
+		}
+
+		QueueComponentEvent(ComponentEvent::Update, GetComponentId<T>(), e.GetId());
+	}
+
+	template<typename T>
+	void Registry::OnConstruct(ComponentListener listener)
+	{
+		AddComponentListener<T>(ComponentEvent::Construct, std::move(listener));
+	}
+
+	template<typename T>
+	void Registry::OnUpdate(ComponentListener listener)
+	{
+		AddComponentListener<T>(ComponentEvent::Update, std::move(listener));
+	}
+
+	template<typename T>
+	void Registry::OnDestroy(ComponentListener listener)
+	{
+		AddComponentListener<T>(ComponentEvent::Destroy, std::move(listener));
+	}
+
+	template<typename T>
+	void Registry::ClearObservers()
+	{
+		const u32 componentId = GetComponentId<T>();
+		if (componentId < m_observers.size())
+			m_observers[componentId] = ComponentObservers{};
+	}
+
+	template<typename T>
+	void Registry::AddComponentListener(ComponentEvent event, ComponentListener listener)
+	{
+		const u32 componentId = AssignComponentId<T>();
+		if (componentId >= m_observers.size())
+			m_observers.resize(componentId + 1);
+
+		m_observers[componentId].listeners[(size_t)event].push_back(std::move(listener));
+	}
+
+	inline void Registry::QueueComponentEvent(ComponentEvent event, u32 componentId, EntityID entityId)
+	{
+		// Only recorded when someone listens
+		if (componentId < m_observers.size() && !m_observers[componentId].listeners[(size_t)event].empty())
+			m_observers[componentId].pending[(size_t)event].push_back(entityId);
+	}
+
+	template<typename T, typename ...TArgs>
+	void Registry::ReplaceComponent(Entity e, TArgs&& ...args)
+	{
+		if (!HasComponent<T>(e))
+		{
+			AddComponent<T>(e, std::forward<TArgs>(args)...);
+			return;
+		}
+
+		GetComponent<T>(e) = T(std::forward<TArgs>(args)...);
+		MarkChanged<T>(e);
 	}
 
 	template<typename T>
 	bool Registry::HasComponent(Entity e) const
 	{
-		const auto componentId = Component<T>::GetId();
+		const u32 componentId = GetComponentId<T>();
 		const auto entityId = e.GetId();
 
-		return m_entityComponentSignatures[entityId].test(componentId);
+		return componentId != u32_invalid_id && m_entityComponentSignatures[GetEntityIndex(entityId)].test(componentId);
 	}
 
 	template<typename T>
-	T& Registry::GetComponent(Entity e) const
+	ComponentRef<T> Registry::GetComponent(Entity e) const
 	{
-		const auto componentId = Component<T>::GetId();
+		const u32 componentId = GetComponentId<T>();
+		if (m_archetypes)
+			return ComponentRef<T>(*static_cast<T*>(m_archetypes->Get(e.GetId(), componentId)));
+
 		auto* pool = static_cast<Pool<T>*>(m_componentPools[componentId].get());
 
 		return pool->Get(e.GetId());
 	}
 
+	template<typename T>
+	ConstComponentRef<T> Registry::GetConstComponent(Entity e) const
+	{
+		const u32 componentId = GetComponentId<T>();
+		if (m_archetypes)
+			return ConstComponentRef<T>(*static_cast<const T*>(m_archetypes->Get(e.GetId(), componentId)));
+
+		const auto* pool = static_cast<const Pool<T>*>(m_componentPools[componentId].get());
+
+		return pool->Get(e.GetId());
+	}
+
 	// System management
 	template<typename T, typename ...TArgs>
 	void Registry::AddSystem(TArgs&& ...args)
 	{
 		auto newSystem = std::make_shared<T>(std::forward<TArgs>(args)...);
-		m_systems.insert(std::make_pair(std::type_index(typeid(T)), newSystem));
+		if (m_systems.insert(std::make_pair(std::type_index(typeid(T)), newSystem)).second)
+		{
+			newSystem->m_name = GetTypeName<T>();
+			BindSystem(*newSystem);
+			m_systemOrder.push_back(newSystem);
+			m_systemGraphDirty = true;
+			m_systemIndexDirty = true;
+		}
 	}
 
 	template<typename T>
 	void Registry::RemoveSystem()
 	{
 		auto system = m_systems.find(std::type_index(typeid(T)));
+		std::erase(m_systemOrder, system->second);
 		m_systems.erase(system);
+		m_systemGraphDirty = true;
+		m_systemIndexDirty = true;
 	}
 
 	template<typename T>
@@ -410,15 +1821,58 @@ namespace ECS
 		return *(std::static_pointer_cast<T>(system->second));
 	}
 
+	template<typename... Components>
+	void Registry::RegisterComponents()
+	{
+		(AssignComponentId<Components>(), ...);
+
+		if (!m_archetypes && m_componentPools.size() < m_componentCount)
+		{
+			m_componentPools.resize(m_componentCount);
+			m_pendingPoolRemovals.resize(m_componentCount);
+		}
+	}
+
+	template<typename... Components>
+	Signature Registry::MakeSignature()
+	{
+		Signature signature;
+		(signature.set(AssignComponentId<Components>()), ...);
+		return signature;
+	}
+
 	template<typename T>
 	Pool<T>* Registry::GetPool() const
 	{
-		const auto componentId = Component<T>::GetId();
+		const u32 componentId = GetComponentId<T>();
 		if (componentId >= m_componentPools.size() || !m_componentPools[componentId])
 			return nullptr;
 
 		return static_cast<Pool<T>*>(m_componentPools[componentId].get());
 	}
+
+	template<typename T>
+	Pool<T>* Registry::GetOrCreatePool()
+	{
+		const u32 componentId = AssignComponentId<T>();
+
+		if (componentId >= m_componentPools.size())
+		{
+			m_componentPools.resize(componentId + 1);
+			m_pendingPoolRemovals.resize(componentId + 1);
+		}
+
+		// If we still don't have a Pool for that component type
+		if (!m_componentPools[componentId])
+			m_componentPools[componentId] = MakeResourceUnique<Pool<T>>(m_memoryResource, PAGE_SIZE, *m_pageAllocator, m_memoryResource);
+
+		return static_cast<Pool<T>*>(m_componentPools[componentId].get());
+	}
 }
 
-#include "Entity.inl"
\ No newline at end of file
+#include "Entity.inl"
+#include "Query.inl"
+#include "CommandBuffer.inl"
+#include "Snapshot.inl"
+#include "Delta.inl"
+#include "Sort.inl"
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace ECS
+{
+	// Deleter of an object allocated by MakeResourceUnique(). Keeps the size of the allocation,
+	// so that a ResourcePtr<Base> can own (and give back) a derived object
+	struct ResourceDeleter
+	{
+		std::pmr::memory_resource* resource = nullptr;
+		size_t size = 0;
+		size_t alignment = 0;
+
+		template<typename T>
+		void operator()(T* object) const
+		{
+			object->~T();
+			resource->deallocate(object, size, alignment);
+		}
+	};
+
+	// unique_ptr to an object living in a memory resource
+	template<typename T> using ResourcePtr = std::unique_ptr<T, ResourceDeleter>;
+
+	/**
+	 * @brief Construct an object in memory taken from a memory resource.
+	 *
+	 * @param resource Memory resource to allocate the object from.
+	 * @param args Constructor arguments.
+	 * @return ResourcePtr<T> The object, given back to the resource when destroyed.
+	 */
+	template<typename T, typename... TArgs>
+	ResourcePtr<T> MakeResourceUnique(std::pmr::memory_resource* resource, TArgs&&... args)
+	{
+		void* memory = resource->allocate(sizeof(T), alignof(T));
+		try
+		{
+			return ResourcePtr<T>(new (memory) T(std::forward<TArgs>(args)...), ResourceDeleter{ resource, sizeof(T), alignof(T) });
+		}
+		catch (...)
+		{
+			resource->deallocate(memory, sizeof(T), alignof(T));
+			throw;
+		}
+	}
+}
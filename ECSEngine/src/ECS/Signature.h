@@ -0,0 +1,203 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "../PrimitiveTypes.h"
+
+#include <bit>
+#include <algorithm>
+#include <cstddef>
+
+namespace ECS
+{
+	// Fixed-size bitset used for component signatures.
+	// Same interface as std::bitset for the operations the ECS needs (set/test/reset/&/|/==),
+	// plus direct access to the 64-bit words so subset tests and bit iteration stay cheap:
+	// the word loops have no early exit and auto-vectorize at 128/256/512 bits, and a
+	// signature of up to 64 components is a single word.
+	template<size_t Bits>
+	class BasicSignature
+	{
+	public:
+		static constexpr size_t WORD_BITS = 64;
+		static constexpr size_t WORD_COUNT = (Bits + WORD_BITS - 1) / WORD_BITS;
+
+		constexpr BasicSignature() = default;
+
+		static constexpr size_t size() { return Bits; }
+
+		BasicSignature& set(size_t pos, bool value = true)
+		{
+			const u64 mask = (u64)1 << (pos % WORD_BITS);
+			if (value)
+				m_words[pos / WORD_BITS] |= mask;
+			else
+				m_words[pos / WORD_BITS] &= ~mask;
+			return *this;
+		}
+
+		bool test(size_t pos) const
+		{
+			return (m_words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+		}
+
+		BasicSignature& reset()
+		{
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				m_words[i] = 0;
+			return *this;
+		}
+
+		bool any() const
+		{
+			u64 bits = 0;
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				bits |= m_words[i];
+			return bits != 0;
+		}
+
+		bool none() const { return !any(); }
+
+		size_t count() const
+		{
+			size_t bits = 0;
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				bits += (size_t)std::popcount(m_words[i]);
+			return bits;
+		}
+
+		/**
+		 * @brief Check whether every bit set in other is also set in this signature.
+		 *	Same as (*this & other) == other, without building a temporary.
+		 * @param other The signature to test.
+		 * @return true If other is a subset of this signature.
+		 * @return false Otherwise.
+		 */
+		bool Contains(const BasicSignature& other) const
+		{
+			u64 missing = 0;
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				missing |= other.m_words[i] & ~m_words[i];
+			return missing == 0;
+		}
+
+		/**
+		 * @brief Check whether this signature and other have at least one bit in common.
+		 *
+		 * @param other The signature to test.
+		 * @return true If both signatures share a bit.
+		 * @return false Otherwise.
+		 */
+		bool Intersects(const BasicSignature& other) const
+		{
+			u64 common = 0;
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				common |= other.m_words[i] & m_words[i];
+			return common != 0;
+		}
+
+		/**
+		 * @brief Call func(u32 pos) for every set bit, in increasing order.
+		 *
+		 * @tparam Func Callable taking the bit position.
+		 * @param func The function to call.
+		 */
+		template<typename Func>
+		void ForEachSetBit(Func&& func) const
+		{
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+			{
+				u64 word = m_words[i];
+				while (word)
+				{
+					func((u32)(i * WORD_BITS + std::countr_zero(word)));
+					word &= word - 1;
+				}
+			}
+		}
+
+		/**
+		 * @brief Get a hash of the signature, to use it as a key.
+		 *
+		 * @return size_t Hash value.
+		 */
+		size_t Hash() const
+		{
+			u64 hash = 14695981039346656037ull;
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+			{
+				hash ^= m_words[i];
+				hash *= 1099511628211ull;
+			}
+			return (size_t)hash;
+		}
+
+		BasicSignature& operator&=(const BasicSignature& other)
+		{
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				m_words[i] &= other.m_words[i];
+			return *this;
+		}
+
+		BasicSignature& operator|=(const BasicSignature& other)
+		{
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				m_words[i] |= other.m_words[i];
+			return *this;
+		}
+
+		BasicSignature& operator^=(const BasicSignature& other)
+		{
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				m_words[i] ^= other.m_words[i];
+			return *this;
+		}
+
+		friend BasicSignature operator&(BasicSignature a, const BasicSignature& b) { return a &= b; }
+		friend BasicSignature operator|(BasicSignature a, const BasicSignature& b) { return a |= b; }
+		friend BasicSignature operator^(BasicSignature a, const BasicSignature& b) { return a ^= b; }
+
+		bool operator==(const BasicSignature& other) const
+		{
+			u64 diff = 0;
+			for (size_t i = 0; i < WORD_COUNT; ++i)
+				diff |= m_words[i] ^ other.m_words[i];
+			return diff == 0;
+		}
+
+		/**
+		 * @brief Direct access to the 64-bit words (bit i is bit i % 64 of word i / 64).
+		 *
+		 * @return const u64* Pointer to WORD_COUNT words.
+		 */
+		const u64* GetWords() const { return m_words; }
+		u64* GetWords() { return m_words; }
+
+	private:
+		// Aligned on its size (up to a cache line) so wide signatures load in one vector op
+		alignas(std::min<size_t>(std::bit_ceil(WORD_COUNT * sizeof(u64)), 64)) u64 m_words[WORD_COUNT] = {};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "Snapshot.h"
+#include "Registry.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ECS
+{
+	static size_t AlignSnapshotSize(size_t size)
+	{
+		return (size + SNAPSHOT_ALIGNMENT - 1) & ~(SNAPSHOT_ALIGNMENT - 1);
+	}
+
+	void SnapshotWriter::Write(const void* data, size_t size)
+	{
+		static const char padding[SNAPSHOT_ALIGNMENT] = {};
+
+		if (size)
+			m_stream.write(static_cast<const char*>(data), (std::streamsize)size);
+		m_stream.write(padding, (std::streamsize)(AlignSnapshotSize(size) - size));
+	}
+
+	const u8* SnapshotReader::Read(size_t size)
+	{
+		if (m_offset + size > m_size)
+			return nullptr;
+
+		const u8* block = m_data + m_offset;
+		m_offset = std::min(m_offset + AlignSnapshotSize(size), m_size);
+		return block;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!data)
+		{
+			if (mapping)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_data = static_cast<const u8*>(data);
+		m_size = (size_t)size.QuadPart;
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd); // The mapping stays valid without the descriptor
+		if (data == MAP_FAILED)
+			return false;
+
+		m_data = static_cast<const u8*>(data);
+		m_size = (size_t)info.st_size;
+#endif
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (!m_data)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		CloseHandle(m_file);
+		m_file = nullptr;
+		m_mapping = nullptr;
+#else
+		munmap(const_cast<u8*>(m_data), m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	void Registry::SaveSnapshotEntities(SnapshotWriter& writer, u32 poolCount) const
+	{
+		SnapshotHeader header;
+		header.entityCount = (u32)m_numEntities;
+		header.freeCount = m_freeCount;
+		header.poolCount = poolCount;
+		writer.Write(&header, sizeof(header));
+
+		// The versions and the free list are threaded through the entity slots, copy them to contiguous blocks.
+		// Retired indices keep u32_invalid_id as version.
+		std::vector<u32> versions(header.entityCount);
+		for (u32 index = 0; index < header.entityCount; ++index)
+			versions[index] = GetEntityVersion(m_entitySlots[index]);
+		writer.Write(versions.data(), versions.size() * sizeof(u32));
+
+		// In reuse order
+		std::vector<u32> freeIndices;
+		freeIndices.reserve(m_freeCount);
+		for (u32 index = m_freeHead; index != u32_invalid_id; index = GetEntityIndex(m_entitySlots[index]))
+			freeIndices.push_back(index);
+		writer.Write(freeIndices.data(), freeIndices.size() * sizeof(u32));
+	}
+
+	bool SnapshotEntities::CheckPoolEntities(const SnapshotPoolBlock& block, u32 blockIndex)
+	{
+		for (u32 i = 0; i < block.header->count; ++i)
+		{
+			const EntityID entityId = block.entities[i];
+			const u32 index = GetEntityIndex(entityId);
+			if (index >= header->entityCount || !alive[index] || GetEntityVersion(entityId) != versions[index] || lastBlock[index] == blockIndex)
+				return false;
+
+			lastBlock[index] = blockIndex;
+		}
+		return true;
+	}
+
+	bool Registry::ReadSnapshotEntities(SnapshotReader& reader, SnapshotEntities& entities)
+	{
+		const SnapshotHeader* header = reader.Read<SnapshotHeader>(1);
+		if (!header || header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION)
+			return false;
+
+		const u32* versions = reader.Read<u32>(header->entityCount);
+		const u32* freeIndices = reader.Read<u32>(header->freeCount);
+		if (!versions || !freeIndices || header->freeCount > header->entityCount)
+			return false;
+
+		// Free and retired indices are not alive, every other index is
+		std::vector<bool> alive(header->entityCount);
+		for (u32 index = 0; index < header->entityCount; ++index)
+			alive[index] = versions[index] != u32_invalid_id;
+		for (u32 i = 0; i < header->freeCount; ++i)
+		{
+			if (freeIndices[i] >= header->entityCount || !alive[freeIndices[i]])
+				return false;
+			alive[freeIndices[i]] = false;
+		}
+
+		entities.header = header;
+		entities.versions = versions;
+		entities.freeIndices = freeIndices;
+		entities.alive = std::move(alive);
+		entities.lastBlock.assign(header->entityCount, u32_invalid_id);
+		return true;
+	}
+
+	void Registry::LoadSnapshotEntities(const SnapshotEntities& entities)
+	{
+		const SnapshotHeader* header = entities.header;
+		const u32* versions = entities.versions;
+		const u32* freeIndices = entities.freeIndices;
+		const std::vector<bool>& alive = entities.alive;
+
+		m_numEntities = (int)header->entityCount;
+		m_entitySlots.resize(header->entityCount);
+		for (u32 index = 0; index < header->entityCount; ++index)
+			m_entitySlots[index] = CreateEntityId(alive[index] ? index : u32_invalid_id, versions[index]);
+		m_entityComponentSignatures.assign(header->entityCount, Signature());
+		m_systemSyncPending.assign(header->entityCount, false);
+
+		// Pushed last first, so that the indices are reused in the saved order
+		for (u32 i = header->freeCount; i-- > 0;)
+			PushFreeIndex(freeIndices[i], versions[freeIndices[i]]);
+
+		// Alive entities join the systems in the next Update(), like newly created ones
+		for (u32 index = 0; index < header->entityCount; ++index)
+		{
+			if (!alive[index])
+				continue;
+
+			m_systemSyncPending[index] = true;
+			m_entitiesToBeAdded.emplace_back(CreateEntityId(index, versions[index]), this);
+		}
+	}
+}
@@ -0,0 +1,188 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Common.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ECS
+{
+	// Binary snapshot format (see Registry::SaveSnapshot), native endianness:
+	// SnapshotHeader, entity versions (u32[entityCount]), free indices (u32[freeCount]),
+	// then per pool a SnapshotPoolHeader, its packed entity ids (EntityID[count]) and components (T[count]).
+	// Every block starts on a SNAPSHOT_ALIGNMENT boundary so it can be used in place from a mapped file.
+	constexpr u32 SNAPSHOT_MAGIC = 0x53534345; // "ECSS"
+	constexpr u32 SNAPSHOT_VERSION = 2;
+	constexpr size_t SNAPSHOT_ALIGNMENT = CACHE_LINE_SIZE;
+
+	struct SnapshotHeader
+	{
+		u32 magic = SNAPSHOT_MAGIC;
+		u32 version = SNAPSHOT_VERSION;
+		u32 entityCount = 0; // Entity indices in use (alive or free)
+		u32 freeCount = 0;
+		u32 poolCount = 0;
+		u32 reserved = 0;
+	};
+
+	struct SnapshotPoolHeader
+	{
+		u64 typeHash = 0; // Component<T>::GetTypeHash(), stable across runs unlike component ids
+		u32 componentSize = 0;
+		u32 count = 0;
+	};
+
+	// Pool block of a snapshot, pointing into the mapped file
+	struct SnapshotPoolBlock
+	{
+		const SnapshotPoolHeader* header = nullptr;
+		const EntityID* entities = nullptr;
+		const u8* data = nullptr;
+	};
+
+	// Entity blocks of a snapshot, read and checked before anything is loaded (see Registry::LoadSnapshot())
+	struct SnapshotEntities
+	{
+		const SnapshotHeader* header = nullptr;
+		const u32* versions = nullptr;
+		const u32* freeIndices = nullptr;
+		std::vector<bool> alive; // Per index, neither free nor retired
+		std::vector<u32> lastBlock; // Per index, last pool block listing it
+
+		/**
+		 * @brief Check the entity ids of a pool block: alive in the snapshot, and each listed once.
+		 *
+		 * @param block The pool block.
+		 * @param blockIndex Index of the block in the file, distinguishes the blocks for the duplicates.
+		 * @return true If every id is valid.
+		 * @return false Otherwise.
+		 */
+		bool CheckPoolEntities(const SnapshotPoolBlock& block, u32 blockIndex);
+	};
+
+	// Sequential writer of aligned snapshot blocks
+	class SnapshotWriter
+	{
+	public:
+		/**
+		 * @brief Open the file to write, truncating it.
+		 *
+		 * @param path File path.
+		 */
+		explicit SnapshotWriter(const std::string& path) : m_stream(path, std::ios::binary | std::ios::trunc) {}
+
+		/**
+		 * @brief Write a block, padded to SNAPSHOT_ALIGNMENT.
+		 *
+		 * @param data Block data.
+		 * @param size Block size in bytes.
+		 */
+		void Write(const void* data, size_t size);
+
+		/**
+		 * @brief Check whether every write succeeded so far.
+		 *
+		 * @return true If the file is valid.
+		 * @return false Otherwise.
+		 */
+		bool IsValid() { return m_stream.good(); }
+
+	private:
+		std::ofstream m_stream;
+	};
+
+	// Read-only view of a whole file, memory-mapped where the platform allows it
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/**
+		 * @brief Map a file, closing any previously mapped one.
+		 *
+		 * @param path File path.
+		 * @return true If the file was mapped.
+		 * @return false If it could not be opened (or is empty).
+		 */
+		bool Open(const std::string& path);
+
+		/**
+		 * @brief Unmap the file.
+		 */
+		void Close();
+
+		const u8* GetData() const { return m_data; }
+		size_t GetSize() const { return m_size; }
+
+	private:
+		const u8* m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+#endif
+	};
+
+	// Sequential reader of aligned snapshot blocks from a mapped file
+	class SnapshotReader
+	{
+	public:
+		/**
+		 * @brief Construct a reader over a mapped file.
+		 *
+		 * @param file The mapped file.
+		 */
+		explicit SnapshotReader(const MappedFile& file) : m_data(file.GetData()), m_size(file.GetSize()) {}
+
+		/**
+		 * @brief Get the next block and skip it (with its padding).
+		 *
+		 * @param size Block size in bytes.
+		 * @return const u8* The block, nullptr if the file is too short.
+		 */
+		const u8* Read(size_t size);
+
+		/**
+		 * @brief Get the next block as an array of count elements of T.
+		 *
+		 * @param count Number of elements.
+		 * @return const T* The block, nullptr if the file is too short.
+		 */
+		template<typename T>
+		const T* Read(size_t count) { return reinterpret_cast<const T*>(Read(count * sizeof(T))); }
+
+	private:
+		const u8* m_data;
+		size_t m_size;
+		size_t m_offset = 0;
+	};
+}
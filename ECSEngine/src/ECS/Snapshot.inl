@@ -0,0 +1,107 @@
+// Implementation of Registry snapshot template methods
+// Included from Registry.h after Registry is defined
+
+namespace ECS
+{
+	template<typename... Components>
+	bool Registry::SaveSnapshot(const std::string& path) const
+	{
+		static_assert(((std::is_trivially_copyable_v<Components> && !SoAComponent<Components>) && ...),
+			"Snapshot components must be trivially copyable and use the default pool");
+		assert(m_storageMode == StorageMode::SparseSet && "Snapshots need StorageMode::SparseSet");
+		assert(m_entitiesToBeKilled.empty() && "Call Update() before saving a snapshot");
+
+		SnapshotWriter writer(path);
+		SaveSnapshotEntities(writer, (u32)sizeof...(Components));
+
+		auto savePool = [this, &writer]<typename T>() {
+			const Pool<T>* pool = GetPool<T>();
+
+			SnapshotPoolHeader header;
+			header.typeHash = Component<T>::GetTypeHash();
+			header.componentSize = (u32)ComponentDataSize<T>;
+			header.count = pool ? (u32)pool->GetSize() : 0;
+			writer.Write(&header, sizeof(header));
+
+			if (pool)
+			{
+				writer.Write(pool->GetEntities().data(), header.count * sizeof(EntityID));
+				if constexpr (EmptyComponent<T>)
+					writer.Write(nullptr, 0);
+				else
+					writer.Write(pool->GetData().data(), header.count * sizeof(T));
+			}
+			else
+			{
+				writer.Write(nullptr, 0);
+				writer.Write(nullptr, 0);
+			}
+		};
+		(savePool.template operator()<Components>(), ...);
+
+		return writer.IsValid();
+	}
+
+	template<typename... Components>
+	bool Registry::LoadSnapshot(const std::string& path)
+	{
+		static_assert(((std::is_trivially_copyable_v<Components> && !SoAComponent<Components>) && ...),
+			"Snapshot components must be trivially copyable and use the default pool");
+		assert(m_storageMode == StorageMode::SparseSet && "Snapshots need StorageMode::SparseSet");
+		assert(m_numEntities == 0 && "Snapshots are loaded into an empty registry");
+
+		MappedFile file;
+		if (!file.Open(path))
+			return false;
+
+		SnapshotReader reader(file);
+		SnapshotEntities snapshotEntities;
+		if (!ReadSnapshotEntities(reader, snapshotEntities))
+			return false;
+
+		// Every block is checked before the registry is modified, one block per listed type
+		std::array<SnapshotPoolBlock, sizeof...(Components)> blocks;
+		for (u32 i = 0; i < snapshotEntities.header->poolCount; ++i)
+		{
+			SnapshotPoolBlock block;
+			block.header = reader.Read<SnapshotPoolHeader>(1);
+			block.entities = block.header ? reader.Read<EntityID>(block.header->count) : nullptr;
+			block.data = block.header ? reader.Read((size_t)block.header->count * block.header->componentSize) : nullptr;
+			if (!block.header || !block.entities || !block.data)
+				return false;
+
+			// Pools of types that are not listed are skipped
+			bool valid = true;
+			size_t typeIndex = 0;
+			auto checkPool = [&]<typename T>() {
+				SnapshotPoolBlock& typeBlock = blocks[typeIndex++];
+				if (block.header->typeHash != Component<T>::GetTypeHash())
+					return;
+
+				valid = !typeBlock.header && block.header->componentSize == ComponentDataSize<T> && snapshotEntities.CheckPoolEntities(block, i);
+				typeBlock = block;
+			};
+			(checkPool.template operator()<Components>(), ...);
+			if (!valid)
+				return false;
+		}
+
+		LoadSnapshotEntities(snapshotEntities);
+
+		size_t typeIndex = 0;
+		auto loadPool = [&]<typename T>() {
+			const SnapshotPoolBlock& block = blocks[typeIndex++];
+			if (!block.header)
+				return;
+
+			// The blocks are aligned in the file, the components are copied straight from the mapping
+			GetOrCreatePool<T>()->Assign(std::span<const EntityID>(block.entities, block.header->count), reinterpret_cast<const T*>(block.data));
+			const u32 componentId = GetComponentId<T>();
+			for (u32 j = 0; j < block.header->count; ++j)
+				OnComponentAdded(block.entities[j], componentId);
+		};
+		(loadPool.template operator()<Components>(), ...);
+
+		return true;
+	}
+}
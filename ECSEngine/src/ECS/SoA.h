@@ -0,0 +1,160 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+#include "AlignedAllocator.h"
+
+#include <tuple>
+
+namespace ECS
+{
+	// Opt-in structure-of-arrays storage for an aggregate component.
+	// Specialize SoALayout and list every field of the component:
+	//
+	//	template<> struct ECS::SoALayout<Transform>
+	//	{
+	//		static constexpr auto fields = std::make_tuple(&Transform::position, &Transform::rotation, &Transform::scale);
+	//	};
+	//
+	// Its Pool then stores one array per field, and views/GetComponent() hand out SoARef<Transform>
+	// proxies instead of Transform&. The component must be default constructible.
+	template<typename T> struct SoALayout;
+
+	template<typename T>
+	concept SoAComponent = requires { SoALayout<T>::fields; };
+
+	template<typename Member> struct MemberTraits;
+	template<typename Class, typename Field> struct MemberTraits<Field Class::*> { using Type = Field; };
+
+	template<typename T> using SoAFields = std::remove_cvref_t<decltype(SoALayout<T>::fields)>;
+	template<typename T> constexpr size_t SoAFieldCount = std::tuple_size_v<SoAFields<T>>;
+	template<typename T, size_t I> using SoAFieldType = typename MemberTraits<std::tuple_element_t<I, SoAFields<T>>>::Type;
+
+	// Position of Member in SoALayout<T>::fields
+	template<typename T, auto Member, size_t I = 0>
+	constexpr size_t SoAFieldIndex()
+	{
+		static_assert(I < SoAFieldCount<T>, "Member is not listed in the SoALayout");
+
+		if constexpr (std::is_same_v<std::tuple_element_t<I, SoAFields<T>>, decltype(Member)>)
+		{
+			if constexpr (std::get<I>(SoALayout<T>::fields) == Member)
+				return I;
+			else
+				return SoAFieldIndex<T, Member, I + 1>();
+		}
+		else
+			return SoAFieldIndex<T, Member, I + 1>();
+	}
+
+	template<typename T, typename Sequence = std::make_index_sequence<SoAFieldCount<T>>> struct SoAStorage;
+	template<typename T, size_t... I>
+	struct SoAStorage<T, std::index_sequence<I...>>
+	{
+		using Columns = std::tuple<std::vector<SoAFieldType<T, I>, AlignedAllocator<SoAFieldType<T, I>, CACHE_LINE_SIZE>>...>;
+		using References = std::tuple<SoAFieldType<T, I>&...>;
+
+		static Columns MakeColumns(std::pmr::memory_resource* resource)
+		{
+			return Columns(AlignedAllocator<SoAFieldType<T, I>, CACHE_LINE_SIZE>(resource)...);
+		}
+	};
+
+	// Proxy reference to an SoA component, one reference per field
+	template<typename T>
+	class SoARef
+	{
+	public:
+		using References = typename SoAStorage<T>::References;
+
+		explicit SoARef(References references) : m_references(references) {}
+
+		/**
+		 * @brief View a whole component object through the proxy.
+		 *
+		 * @param object The component.
+		 */
+		explicit SoARef(T& object) : m_references(FromObject(object, std::make_index_sequence<SoAFieldCount<T>>())) {}
+
+		/**
+		 * @brief Get a field by member pointer, e.g. Get<&Transform::position>().
+		 *
+		 * @return auto& Reference to the field.
+		 */
+		template<auto Member> auto& Get() const { return std::get<SoAFieldIndex<T, Member>()>(m_references); }
+
+		/**
+		 * @brief Get a field by its position in the SoALayout.
+		 *
+		 * @return auto& Reference to the field.
+		 */
+		template<size_t I> auto& Get() const { return std::get<I>(m_references); }
+
+		/**
+		 * @brief Gather the fields into a component copy.
+		 */
+		operator T() const { return Gather(std::make_index_sequence<SoAFieldCount<T>>()); }
+
+		/**
+		 * @brief Scatter a component value into the fields.
+		 */
+		const SoARef& operator=(const T& value) const
+		{
+			Scatter(value, std::make_index_sequence<SoAFieldCount<T>>());
+			return *this;
+		}
+
+	private:
+		template<size_t... I>
+		static References FromObject(T& object, std::index_sequence<I...>)
+		{
+			return References(object.*std::get<I>(SoALayout<T>::fields)...);
+		}
+
+		template<size_t... I>
+		T Gather(std::index_sequence<I...>) const
+		{
+			T value{};
+			((value.*std::get<I>(SoALayout<T>::fields) = std::get<I>(m_references)), ...);
+			return value;
+		}
+
+		template<size_t... I>
+		void Scatter(const T& value, std::index_sequence<I...>) const
+		{
+			((std::get<I>(m_references) = value.*std::get<I>(SoALayout<T>::fields)), ...);
+		}
+
+	private:
+		References m_references;
+	};
+
+	// What views and GetComponent() hand out for a component type
+	template<typename T> using ComponentRef = std::conditional_t<SoAComponent<T>, SoARef<T>, T&>;
+	// What read-only views and GetConstComponent() hand out, a gathered copy for SoA components
+	template<typename T> using ConstComponentRef = std::conditional_t<SoAComponent<T>, T, const T&>;
+}
\ No newline at end of file
@@ -0,0 +1,325 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "SoA.h"
+
+namespace ECS
+{
+	// Pool of an SoA component (see SoALayout): same interface as Pool<T>, but every field
+	// is stored in its own packed array and components are accessed through SoARef<T>.
+	template <SoAComponent T>
+	class Pool<T> final : public IPool
+	{
+	public:
+		using Reference = SoARef<T>;
+
+		/**
+		 * @brief Construct a new Pool object.
+		 *
+		 * @param pageSize Number of entities per sparse page, must be a power of two.
+		 * @param allocator Allocator providing the sparse pages.
+		 * @param resource Memory resource of the packed arrays.
+		 */
+		explicit Pool(u32 pageSize = PAGE_SIZE, PageAllocator& allocator = PageAllocator::GetDefault(),
+			std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: m_columns(SoAStorage<T>::MakeColumns(resource)), m_packed(resource), m_sparse(pageSize, allocator)
+		{
+			Reserve(DEFAULT_CAPACITY);
+		}
+
+		/**
+		 * @brief Destroy the Pool object.
+		 */
+		virtual ~Pool() = default;
+
+		bool IsEmpty() const { return m_packed.empty(); }
+		int GetSize() const { return (int)m_packed.size(); }
+
+		/**
+		 * @brief Reserve storage for at least capacity components, in every field array.
+		 *
+		 * @param capacity Number of components to reserve storage for.
+		 */
+		void Reserve(size_t capacity)
+		{
+			ForEachColumn([capacity](auto& column) { column.reserve(capacity); });
+			m_packed.reserve(capacity);
+		}
+
+		void SetPageSize(u32 pageSize) { m_sparse.SetPageSize(pageSize); }
+		void ShrinkToFit() override { m_sparse.ShrinkToFit(); }
+		const SparseIndex& GetSparse() const { return m_sparse; }
+
+		void Clear() override
+		{
+			Touch();
+			if (m_changeTracker)
+				m_changeTracker->OnCleared(m_packed);
+
+			ForEachColumn([](auto& column) { column.clear(); });
+			m_packed.clear();
+			m_sparse.Clear();
+
+			if (m_owningGroup)
+				m_owningGroup->OnPoolCleared();
+		}
+
+		bool Has(EntityID entityId) const
+		{
+			return m_sparse.Get(GetEntityIndex(entityId)) != u32_invalid_id;
+		}
+
+		/**
+		 * @brief Stamp the component of an entity as changed. No-op without change tracking.
+		 *
+		 * @param entityId Full entity id, must have a component in the pool.
+		 */
+		bool MarkChanged(EntityID entityId)
+		{
+			const u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			assert(packedIndex != u32_invalid_id && "Entity does not have the component");
+			if (packedIndex == u32_invalid_id)
+				return false;
+
+			Touch();
+			if (m_changeTracker)
+				m_changeTracker->OnChanged(packedIndex);
+			return true;
+		}
+
+		/**
+		 * @brief Add a component instance for an entity, scattering its fields.
+		 *
+		 * @param entityId Full entity id.
+		 * @param object Component instance to store.
+		 */
+		void Add(EntityID entityId, T object)
+		{
+			Touch();
+			PushFields(object, std::make_index_sequence<SoAFieldCount<T>>());
+			m_packed.push_back(entityId);
+			m_sparse.Set(GetEntityIndex(entityId), (u32)m_packed.size() - 1);
+
+			if (m_changeTracker)
+				m_changeTracker->OnAdded();
+
+			if (m_owningGroup)
+				m_owningGroup->OnComponentAdded(entityId);
+		}
+
+		/**
+		 * @brief Set or replace the component for an entity, scattering its fields.
+		 *
+		 * If a component exists it will be replaced, otherwise it will be added.
+		 *
+		 * @param entityId Full entity id.
+		 * @param object Component instance to set.
+		 */
+		void Set(EntityID entityId, T object)
+		{
+			Touch();
+			u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			if (packedIndex != u32_invalid_id)
+			{
+				(*this)[packedIndex] = object;
+				if (m_changeTracker)
+					m_changeTracker->OnChanged(packedIndex);
+			}
+			else
+				Add(entityId, std::move(object));
+		}
+
+		/**
+		 * @brief Remove the component for an entity (swap-and-pop in every field array).
+		 *
+		 * @param entityId Full entity id.
+		 */
+		void Remove(EntityID entityId)
+		{
+			if (!Has(entityId))
+				return;
+
+			Touch();
+			if (m_owningGroup)
+				m_owningGroup->OnComponentRemoving(entityId);
+
+			u32 index = GetEntityIndex(entityId);
+
+			u32 indexToRemove = m_sparse.Get(index);
+			u32 indexLast = (u32)m_packed.size() - 1;
+
+			if (m_changeTracker)
+				m_changeTracker->OnRemoved(entityId, indexToRemove);
+
+			if (indexToRemove != indexLast)
+			{
+				u64 lastEntityId = m_packed[indexLast];
+
+				ForEachColumn([indexToRemove, indexLast](auto& column) { column[indexToRemove] = std::move(column[indexLast]); });
+				m_packed[indexToRemove] = lastEntityId;
+
+				m_sparse.Set(GetEntityIndex(lastEntityId), indexToRemove);
+			}
+
+			ForEachColumn([](auto& column) { column.pop_back(); });
+			m_packed.pop_back();
+			m_sparse.Reset(index);
+		}
+
+		void RemoveEntityFromPool(EntityID entityId) override
+		{
+			Remove(entityId);
+		}
+
+		void RemoveEntitiesFromPool(std::span<const EntityID> entityIds) override
+		{
+			if (m_owningGroup)
+				m_owningGroup->OnComponentsRemoving(entityIds);
+
+			const size_t size = RemovePacked(entityIds, m_packed, m_sparse, [this](u32 from, u32 to) {
+				ForEachColumn([from, to](auto& column) { column[to] = std::move(column[from]); });
+				});
+			ForEachColumn([size](auto& column) { column.erase(column.begin() + size, column.end()); });
+		}
+
+		int GetPackedIndex(EntityID entityId) const override
+		{
+			u32 packedIndex = m_sparse.Get(GetEntityIndex(entityId));
+			return packedIndex == u32_invalid_id ? -1 : (int)packedIndex;
+		}
+
+		void SwapPacked(int a, int b) override
+		{
+			if (a == b)
+				return;
+
+			Touch();
+			ForEachColumn([a, b](auto& column) { std::swap(column[a], column[b]); });
+			std::swap(m_packed[a], m_packed[b]);
+
+			if (m_changeTracker)
+				m_changeTracker->OnSwapped((u32)a, (u32)b);
+
+			m_sparse.Set(GetEntityIndex(m_packed[a]), (u32)a);
+			m_sparse.Set(GetEntityIndex(m_packed[b]), (u32)b);
+		}
+
+		/**
+		 * @brief Get a proxy to the component of an entity. The component must exist.
+		 *
+		 * @param entityId Full entity id.
+		 * @return Reference Proxy to the component fields.
+		 */
+		Reference Get(EntityID entityId)
+		{
+			return (*this)[m_sparse.Get(GetEntityIndex(entityId))];
+		}
+		T Get(EntityID entityId) const { return (*this)[m_sparse.Get(GetEntityIndex(entityId))]; }
+
+		/**
+		 * @brief Get a proxy to the component at a packed index.
+		 *	The const overload gathers a copy of the component instead.
+		 * @param index Packed array index.
+		 * @return Reference Proxy to the component fields.
+		 */
+		Reference operator[](unsigned int index)
+		{
+			Touch();
+			return MakeReference(index, std::make_index_sequence<SoAFieldCount<T>>());
+		}
+		T operator[](unsigned int index) const { return Gather(index, std::make_index_sequence<SoAFieldCount<T>>()); }
+
+		/**
+		 * @brief Get the packed array of a field, e.g. GetField<&Transform::position>().
+		 *	Same order as GetEntities(), aligned on CACHE_LINE_SIZE.
+		 * @return auto& The field array.
+		 */
+		template<auto Member> auto& GetField() { Touch(); return std::get<SoAFieldIndex<T, Member>()>(m_columns); }
+		template<auto Member> const auto& GetField() const { return std::get<SoAFieldIndex<T, Member>()>(m_columns); }
+
+		const std::pmr::vector<EntityID>& GetEntities() const override { return m_packed; }
+
+		ResourcePtr<IPool> CreateEmpty(PageAllocator& allocator, std::pmr::memory_resource* resource) const override
+		{
+			return MakeResourceUnique<Pool>(resource, m_sparse.GetPageSize(), allocator, resource);
+		}
+
+		void GetStats(PoolStats& stats) const override
+		{
+			stats.name = GetTypeName<T>();
+			stats.size = m_packed.size();
+			stats.capacity = m_packed.capacity();
+			stats.packedBytes = m_packed.capacity() * sizeof(EntityID);
+			std::apply([&stats](const auto&... columns) {
+				((stats.packedBytes += columns.capacity() * sizeof(typename std::decay_t<decltype(columns)>::value_type)), ...);
+				}, m_columns);
+			stats.sparsePages = m_sparse.GetAllocatedPageCount();
+			stats.sparseBytes = stats.sparsePages * m_sparse.GetPageSize() * sizeof(u32);
+		}
+
+	protected:
+		void CopyData(const IPool& source) override
+		{
+			const Pool& other = static_cast<const Pool&>(source);
+			m_columns = other.m_columns;
+			m_packed = other.m_packed;
+			m_sparse.CopyFrom(other.m_sparse);
+		}
+
+	private:
+		template<typename Func>
+		void ForEachColumn(Func&& func)
+		{
+			std::apply([&func](auto&... columns) { (func(columns), ...); }, m_columns);
+		}
+
+		template<size_t... I>
+		void PushFields(T& object, std::index_sequence<I...>)
+		{
+			(std::get<I>(m_columns).push_back(std::move(object.*std::get<I>(SoALayout<T>::fields))), ...);
+		}
+
+		template<size_t... I>
+		Reference MakeReference(unsigned int index, std::index_sequence<I...>)
+		{
+			return Reference(typename Reference::References(std::get<I>(m_columns)[index]...));
+		}
+
+		template<size_t... I>
+		T Gather(unsigned int index, std::index_sequence<I...>) const
+		{
+			T value{};
+			((value.*std::get<I>(SoALayout<T>::fields) = std::get<I>(m_columns)[index]), ...);
+			return value;
+		}
+
+	private:
+		typename SoAStorage<T>::Columns m_columns; // One packed array per field
+		std::pmr::vector<EntityID> m_packed; // Who (Packed index: Packed index -> EntityID)
+		SparseIndex m_sparse; // Where (Paging sparse index: Entity index -> Packed index, u32_invalid_id if not present)
+	};
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+// Implementation of Registry sorting template methods
+// Included from Registry.h after Registry is defined
+
+namespace ECS
+{
+	// compare(a, b) on the packed slots a and b of a pool, see Registry::Sort()
+	template<typename PoolType, typename Compare>
+	bool ComparePacked(PoolType& pool, Compare& compare, u32 a, u32 b)
+	{
+		if constexpr (std::is_invocable_r_v<bool, Compare&, decltype(pool[a]), decltype(pool[b])>)
+			return compare(pool[a], pool[b]);
+		else
+		{
+			static_assert(std::is_invocable_r_v<bool, Compare&, EntityID, EntityID>,
+				"compare must take two components or two EntityID");
+			return compare(pool.GetEntities()[a], pool.GetEntities()[b]);
+		}
+	}
+
+	template<typename T, typename Compare>
+	void Registry::Sort(Compare compare)
+	{
+		assert(!m_archetypes && "Sort() needs StorageMode::SparseSet");
+
+		Pool<T>* pool = GetPool<T>();
+		if (!pool || pool->GetSize() < 2)
+			return;
+		assert(!pool->GetOwningGroup() && "Pools owned by a group can not be sorted");
+
+		std::vector<u32> order(pool->GetSize());
+		for (u32 i = 0; i < (u32)order.size(); ++i)
+			order[i] = i;
+
+		std::sort(order.begin(), order.end(), [pool, &compare](u32 a, u32 b) { return ComparePacked(*pool, compare, a, b); });
+		pool->Permute(order);
+	}
+
+	template<typename T, typename Compare>
+	bool Registry::SortIncremental(Compare compare, u32 maxSwaps)
+	{
+		assert(!m_archetypes && "SortIncremental() needs StorageMode::SparseSet");
+
+		Pool<T>* pool = GetPool<T>();
+		if (!pool || pool->GetSize() < 2)
+			return true;
+		assert(!pool->GetOwningGroup() && "Pools owned by a group can not be sorted");
+
+		u32 swaps = 0;
+		for (u32 i = 1; i < (u32)pool->GetSize(); ++i)
+		{
+			for (u32 j = i; j > 0 && ComparePacked(*pool, compare, j, j - 1); --j)
+			{
+				if (swaps++ == maxSwaps)
+					return false;
+				pool->SwapPacked((int)j, (int)j - 1);
+			}
+		}
+		return true;
+	}
+
+	template<typename T, typename U>
+	void Registry::SortAs()
+	{
+		assert(!m_archetypes && "SortAs() needs StorageMode::SparseSet");
+
+		Pool<T>* pool = GetPool<T>();
+		const Pool<U>* reference = GetPool<U>();
+		if (!pool || !reference || pool->GetSize() < 2)
+			return;
+		assert(!pool->GetOwningGroup() && "Pools owned by a group can not be sorted");
+
+		// Walk the reference order, moving each entity that has T to the next slot
+		u32 next = 0;
+		for (EntityID entityId : reference->GetEntities())
+		{
+			const int packedIndex = pool->GetPackedIndex(entityId);
+			if (packedIndex == -1)
+				continue;
+
+			pool->SwapPacked(packedIndex, (int)next);
+			next++;
+		}
+	}
+}
@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "SparseIndex.h"
+
+#include <bit>
+#include <cstring>
+
+namespace ECS
+{
+	SparseIndex::SparseIndex(u32 pageSize, PageAllocator& allocator)
+		: m_pages(allocator.GetResource()), m_pageCounts(allocator.GetResource()), m_allocator(&allocator)
+	{
+		SetPageSize(pageSize);
+	}
+
+	SparseIndex::~SparseIndex()
+	{
+		Clear();
+		ShrinkToFit();
+	}
+
+	void SparseIndex::Reset(u32 index)
+	{
+		u32 page = index >> m_pageShift;
+		if (page >= m_pages.size() || !m_pages[page])
+			return;
+
+		u32& entry = m_pages[page][index & m_pageMask];
+		if (entry == u32_invalid_id)
+			return;
+
+		entry = u32_invalid_id;
+
+		// Release the page as soon as it is empty
+		if (--m_pageCounts[page] == 0)
+		{
+			ReleasePage(m_pages[page], true);
+			m_pages[page] = nullptr;
+		}
+	}
+
+	void SparseIndex::Clear()
+	{
+		for (size_t page = 0; page < m_pages.size(); ++page)
+		{
+			if (m_pages[page])
+			{
+				ReleasePage(m_pages[page], m_pageCounts[page] == 0);
+				m_pages[page] = nullptr;
+			}
+		}
+		std::fill(m_pageCounts.begin(), m_pageCounts.end(), 0);
+	}
+
+	void SparseIndex::ShrinkToFit()
+	{
+		if (m_sparePage)
+		{
+			m_allocator->Free(m_sparePage, GetPageSize());
+			m_sparePage = nullptr;
+		}
+	}
+
+	void SparseIndex::ReleasePage(u32* page, bool empty)
+	{
+		if (m_sparePage)
+		{
+			m_allocator->Free(page, GetPageSize());
+			return;
+		}
+
+		if (!empty)
+			std::memset(page, 0xFF, GetPageSize() * sizeof(u32));
+		m_sparePage = page;
+	}
+
+	void SparseIndex::CopyFrom(const SparseIndex& other)
+	{
+		if (GetPageSize() != other.GetPageSize())
+		{
+			Clear();
+			SetPageSize(other.GetPageSize());
+		}
+
+		// Pages past the end of the other index
+		for (size_t page = other.m_pages.size(); page < m_pages.size(); ++page)
+		{
+			if (m_pages[page])
+				ReleasePage(m_pages[page], m_pageCounts[page] == 0);
+		}
+		m_pages.resize(other.m_pages.size(), nullptr);
+
+		for (size_t page = 0; page < m_pages.size(); ++page)
+		{
+			if (other.m_pages[page])
+			{
+				if (!m_pages[page])
+					AllocatePage((u32)page);
+				std::memcpy(m_pages[page], other.m_pages[page], GetPageSize() * sizeof(u32));
+			}
+			else if (m_pages[page])
+			{
+				ReleasePage(m_pages[page], m_pageCounts[page] == 0);
+				m_pages[page] = nullptr;
+			}
+		}
+
+		m_pageCounts = other.m_pageCounts;
+	}
+
+	void SparseIndex::SetPageSize(u32 pageSize)
+	{
+		assert(std::has_single_bit(pageSize) && "Sparse page size must be a power of two");
+		assert(GetAllocatedPageCount() == 0 && "Sparse page size can only change while the index is empty");
+		ShrinkToFit();
+
+		m_pages.clear();
+		m_pageCounts.clear();
+		m_pageShift = (u32)std::countr_zero(pageSize);
+		m_pageMask = pageSize - 1;
+	}
+
+	size_t SparseIndex::GetAllocatedPageCount() const
+	{
+		return (size_t)std::count_if(m_pages.begin(), m_pages.end(), [](const u32* page) { return page != nullptr; });
+	}
+
+	void SparseIndex::AllocatePage(u32 page)
+	{
+		if (page >= m_pages.size())
+		{
+			assert(((u64)page << m_pageShift) < MAX_ENTITIES && "Entity index exceeds maximum allowed entities");
+			m_pages.resize(page + 1, nullptr);
+			m_pageCounts.resize(page + 1, 0);
+		}
+
+		// The spare page is already cleared
+		if (m_sparePage)
+		{
+			m_pages[page] = m_sparePage;
+			m_sparePage = nullptr;
+		}
+		else
+		{
+			m_pages[page] = m_allocator->Allocate(GetPageSize());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+#include "PageAllocator.h"
+
+namespace ECS
+{
+	// Paged sparse index: entity index -> u32 value (a packed index), u32_invalid_id if not present.
+	// Pages are allocated on first write and released as soon as they hold no entry, through a
+	// PageAllocator shared between pools. The last released page is kept as a spare for the next
+	// allocation, so add/remove churn around a page boundary does not go through the allocator.
+	class SparseIndex
+	{
+	public:
+		/**
+		 * @brief Construct a new SparseIndex object.
+		 *
+		 * @param pageSize Number of entries per page, must be a power of two.
+		 * @param allocator Allocator providing the pages.
+		 */
+		explicit SparseIndex(u32 pageSize = PAGE_SIZE, PageAllocator& allocator = PageAllocator::GetDefault());
+
+		/**
+		 * @brief Destroy the SparseIndex object, giving its pages back to the allocator.
+		 */
+		~SparseIndex();
+
+		SparseIndex(const SparseIndex&) = delete;
+		SparseIndex& operator=(const SparseIndex&) = delete;
+
+		/**
+		 * @brief Get the value stored for an entity index.
+		 *
+		 * @param index Entity index.
+		 * @return u32 The value, u32_invalid_id if not present.
+		 */
+		u32 Get(u32 index) const
+		{
+			u32 page = index >> m_pageShift;
+			if (page >= m_pages.size() || !m_pages[page])
+				return u32_invalid_id;
+
+			return m_pages[page][index & m_pageMask];
+		}
+
+		/**
+		 * @brief Store a value for an entity index, allocating its page if needed.
+		 *
+		 * @param index Entity index.
+		 * @param value The value, must not be u32_invalid_id.
+		 */
+		void Set(u32 index, u32 value)
+		{
+			u32 page = index >> m_pageShift;
+			if (page >= m_pages.size() || !m_pages[page])
+				AllocatePage(page);
+
+			u32& entry = m_pages[page][index & m_pageMask];
+			if (entry == u32_invalid_id)
+				m_pageCounts[page]++;
+			entry = value;
+		}
+
+		/**
+		 * @brief Remove the value stored for an entity index.
+		 *	The page is released once it holds no entry, kept as the spare page if there is none.
+		 * @param index Entity index.
+		 */
+		void Reset(u32 index);
+
+		/**
+		 * @brief Remove every value and release every page, but a spare one.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Give the spare page back to the allocator.
+		 */
+		void ShrinkToFit();
+
+		/**
+		 * @brief Make the index a copy of another index, page by page.
+		 *	Pages already allocated on both sides are reused, the others are allocated or released.
+		 * @param other The index to copy.
+		 */
+		void CopyFrom(const SparseIndex& other);
+
+		/**
+		 * @brief Change the number of entries per page. The index must be empty.
+		 *
+		 * @param pageSize Number of entries per page, must be a power of two.
+		 */
+		void SetPageSize(u32 pageSize);
+
+		/**
+		 * @brief Get the number of entries per page.
+		 *
+		 * @return u32 Number of entries per page.
+		 */
+		u32 GetPageSize() const { return m_pageMask + 1; }
+
+		/**
+		 * @brief Get the number of pages currently allocated, the spare page excluded.
+		 *
+		 * @return size_t Number of allocated pages.
+		 */
+		size_t GetAllocatedPageCount() const;
+
+		/**
+		 * @brief Check whether a released page is kept for the next allocation.
+		 *
+		 * @return true If the index holds a spare page.
+		 */
+		bool HasSparePage() const { return m_sparePage != nullptr; }
+
+	private:
+		void AllocatePage(u32 page);
+		// Keep a page as the spare if there is none (cleared unless empty), free it otherwise
+		void ReleasePage(u32* page, bool empty);
+
+	private:
+		// In the memory resource of the allocator, like the pages
+		std::pmr::vector<u32*> m_pages; // nullptr for pages without any entry
+		std::pmr::vector<u32> m_pageCounts; // Number of entries set in each page
+		u32* m_sparePage = nullptr; // Released page without any entry, reused before asking the allocator
+		PageAllocator* m_allocator;
+		u32 m_pageShift = 0;
+		u32 m_pageMask = 0;
+	};
+}
\ No newline at end of file
@@ -29,14 +29,50 @@ namespace ECS
 {
 	void System::AddEntityToSystem(Entity entity)
 	{
+		if (HasEntity(entity))
+			return;
+
+		u32 index = GetEntityIndex(entity.GetId());
+		if (index >= m_entityToIndex.size())
+			m_entityToIndex.resize(index + 1, -1);
+
 		m_entities.emplace_back(entity);
+		m_entityToIndex[index] = (int)m_entities.size() - 1;
+
 		Add(entity); // Call Add callback
 	}
 
 	void System::RemoveEntityFromSystem(Entity entity)
 	{
-		std::erase(m_entities, entity);
-		Remove(entity);
+		if (!HasEntity(entity))
+			return;
+
+		u32 index = GetEntityIndex(entity.GetId());
+		int indexToRemove = m_entityToIndex[index];
+		int indexLast = (int)m_entities.size() - 1;
+
+		// Swap & Pop Logic
+		if (indexToRemove != indexLast)
+		{
+			Entity lastEntity = m_entities[indexLast];
+			m_entities[indexToRemove] = lastEntity;
+			m_entityToIndex[GetEntityIndex(lastEntity.GetId())] = indexToRemove;
+		}
+
+		m_entities.pop_back();
+		m_entityToIndex[index] = -1;
+
+		Remove(entity); // Call Remove callback
+	}
+
+	bool System::HasEntity(Entity entity) const
+	{
+		u32 index = GetEntityIndex(entity.GetId());
+		if (index >= m_entityToIndex.size() || m_entityToIndex[index] == -1)
+			return false;
+
+		// Same slot but different version: a previous entity that used this index
+		return m_entities[m_entityToIndex[index]] == entity;
 	}
 
 	const std::vector<Entity>& System::GetSystemEntities() const
@@ -48,4 +84,20 @@ namespace ECS
 	{
 		return m_componentSignature;
 	}
+
+	const Signature& System::GetReadSignature() const
+	{
+		return m_readSignature;
+	}
+
+	const Signature& System::GetWriteSignature() const
+	{
+		return m_writeSignature;
+	}
+
+	bool System::ConflictsWith(const System& other) const
+	{
+		return m_writeSignature.Intersects(other.m_readSignature | other.m_writeSignature) ||
+			m_readSignature.Intersects(other.m_writeSignature);
+	}
 }
\ No newline at end of file
@@ -41,22 +41,33 @@ namespace ECS
 		/**
 		 * @brief Destroy the System object.
 		 */
-		~System() = default;
+		virtual ~System() = default;
 
 		/**
 		 * @brief Add an entity to the system's internal list.
 		 *	This is used by the Registry when an entity matches the system's signature.
+		 *	Does nothing if the entity is already in the system.
 		 * @param entity The entity to add.
 		 */
 		void AddEntityToSystem(Entity entity);
 
 		/**
-		 * @brief Remove an entity from the system's internal list.
+		 * @brief Remove an entity from the system's internal list in O(1) (swap-and-pop).
 		 *	Called when an entity is killed or no longer matches the system signature.
+		 *	Does nothing if the entity is not in the system.
 		 * @param entity The entity to remove.
 		 */
 		void RemoveEntityFromSystem(Entity entity);
 
+		/**
+		 * @brief Check whether an entity is in the system's internal list.
+		 *
+		 * @param entity The entity to check.
+		 * @return true If the entity is in the system.
+		 * @return false Otherwise.
+		 */
+		bool HasEntity(Entity entity) const;
+
 		/**
 		 * @brief Get the list of entities currently in the system.
 		 *
@@ -65,26 +76,127 @@ namespace ECS
 		const std::vector<Entity>& GetSystemEntities() const;
 
 		/**
-		 * @brief Get the component signature required by the system.
+		 * @brief Get the name of the system type, set by Registry::AddSystem().
 		 *
+		 * @return std::string_view The type name, used by the profiler.
+		 */
+		std::string_view GetName() const { return m_name; }
+
+		/**
+		 * @brief Get the component signature required by the system.
+		 *	In the component ids of the registry the system was added to (see Registry::AddSystem()).
 		 * @return const Signature& Reference to the component signature bitset.
 		 */
 		const Signature& GetComponentSignature() const;
 
+		/**
+		 * @brief Get the components the system only reads.
+		 *
+		 * @return const Signature& Reference to the read-only component bitset.
+		 */
+		const Signature& GetReadSignature() const;
+
+		/**
+		 * @brief Get the components the system reads and writes.
+		 *
+		 * @return const Signature& Reference to the read-write component bitset.
+		 */
+		const Signature& GetWriteSignature() const;
+
+		/**
+		 * @brief Check whether two systems can not run at the same time.
+		 *	They conflict when one writes a component the other reads or writes.
+		 * @param other The other system.
+		 * @return true If the systems access the same component and at least one writes it.
+		 * @return false Otherwise.
+		 */
+		bool ConflictsWith(const System& other) const;
+
 		virtual void Add(Entity entity) {};
 		virtual void Remove(Entity entity) {};
 
+		/**
+		 * @brief Per frame entry point, called by Registry::RunSystems().
+		 *
+		 * Systems that do not conflict run in parallel on the registry thread pool, so an
+		 * implementation must only touch the components it declared and must not create/kill
+		 * entities or add/remove components.
+		 *
+		 * @param deltaTime Elapsed time since the previous frame.
+		 */
+		virtual void Update(f32 deltaTime) {};
+
+		/**
+		 * @brief Require a component, accessed in read-write mode.
+		 *	The requirements are declared in the constructor, before the system joins a registry.
+		 */
 		template<typename T> void RequireComponent();
 
+		/**
+		 * @brief Require a component the system only reads.
+		 *	Systems that only read the same components can run in parallel.
+		 */
+		template<typename T> void ReadComponent();
+
+		/**
+		 * @brief Require a component the system reads and writes.
+		 *	Same as RequireComponent().
+		 */
+		template<typename T> void WriteComponent();
+
 	private:
+		friend class Registry;
+
+		// Components declared with ReadComponent()/WriteComponent(), by Component<T>::GetId().
+		// The registry maps them to its own component ids in the signatures below.
+		struct ComponentAccess
+		{
+			u64 typeId;
+			bool write;
+		};
+		std::vector<ComponentAccess> m_componentAccesses;
+
+		std::string_view m_name;
+
 		Signature m_componentSignature;
+		Signature m_readSignature;
+		Signature m_writeSignature;
 		std::vector<Entity> m_entities;
+		std::vector<int> m_entityToIndex; // Sparse index: Entity index -> index in m_entities, -1 if not present
 	};
 
 	template<typename T>
 	void System::RequireComponent()
 	{
-		const auto componentId = Component<T>::GetId();
-		m_componentSignature.set(componentId);
+		WriteComponent<T>();
+	}
+
+	template<typename T>
+	void System::ReadComponent()
+	{
+		const u64 typeId = Component<T>::GetId();
+
+		// A component written elsewhere in the system stays read-write
+		for (const ComponentAccess& access : m_componentAccesses)
+		{
+			if (access.typeId == typeId)
+				return;
+		}
+		m_componentAccesses.push_back({ typeId, false });
+	}
+
+	template<typename T>
+	void System::WriteComponent()
+	{
+		const u64 typeId = Component<T>::GetId();
+		for (ComponentAccess& access : m_componentAccesses)
+		{
+			if (access.typeId == typeId)
+			{
+				access.write = true;
+				return;
+			}
+		}
+		m_componentAccesses.push_back({ typeId, true });
 	}
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ThreadPool.h"
+
+namespace ECS
+{
+	// Pool and queue of the worker running on the current thread, if any
+	static thread_local ThreadPool* t_threadPool = nullptr;
+	static thread_local u32 t_workerIndex = 0;
+
+	ThreadPool::ThreadPool(u32 workerCount)
+	{
+		// Always keep one queue so tasks can be run by helping threads when there is no worker
+		const u32 queueCount = std::max<u32>(workerCount, 1);
+		m_queues.reserve(queueCount);
+		for (u32 i = 0; i < queueCount; ++i)
+			m_queues.emplace_back(std::make_unique<TaskQueue>());
+
+		m_workers.reserve(workerCount);
+		for (u32 i = 0; i < workerCount; ++i)
+			m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		m_stopping = true;
+		m_pendingTasks.release((std::ptrdiff_t)m_workers.size());
+
+		for (std::thread& worker : m_workers)
+			worker.join();
+	}
+
+	void ThreadPool::Submit(std::function<void()> task)
+	{
+		const u32 queueIndex = (t_threadPool == this)
+			? t_workerIndex
+			: m_nextQueue.fetch_add(1, std::memory_order_relaxed) % (u32)m_queues.size();
+
+		{
+			TaskQueue& queue = *m_queues[queueIndex];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.tasks.emplace_back(std::move(task));
+		}
+		m_pendingTasks.release();
+	}
+
+	bool ThreadPool::RunPendingTask()
+	{
+		std::function<void()> task;
+		const u32 queueCount = (u32)m_queues.size();
+		const bool isWorker = t_threadPool == this;
+		const u32 home = isWorker ? t_workerIndex : 0;
+
+		bool found = isWorker && PopTask(home, task);
+		for (u32 i = 0; i < queueCount && !found; ++i)
+		{
+			u32 victim = (home + i + (isWorker ? 1 : 0)) % queueCount;
+			found = StealTask(victim, task);
+		}
+
+		if (!found)
+			return false;
+
+		task();
+		return true;
+	}
+
+	u32 ThreadPool::GetDefaultWorkerCount()
+	{
+		u32 hardwareThreads = std::thread::hardware_concurrency();
+		return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	void ThreadPool::WorkerLoop(u32 workerIndex)
+	{
+		t_threadPool = this;
+		t_workerIndex = workerIndex;
+
+		while (true)
+		{
+			m_pendingTasks.acquire();
+
+			// The task may already have been taken by another thread
+			if (RunPendingTask())
+				continue;
+
+			// Drain the queues before stopping
+			if (m_stopping)
+				return;
+		}
+	}
+
+	bool ThreadPool::PopTask(u32 queueIndex, std::function<void()>& task)
+	{
+		// Newest first, its data is most likely still in cache
+		TaskQueue& queue = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty())
+			return false;
+
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+		return true;
+	}
+
+	bool ThreadPool::StealTask(u32 queueIndex, std::function<void()>& task)
+	{
+		// Oldest first, to take the largest remaining work from the owner
+		TaskQueue& queue = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty())
+			return false;
+
+		task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+		return true;
+	}
+}
\ No newline at end of file
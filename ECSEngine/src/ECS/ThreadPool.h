@@ -0,0 +1,164 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <thread>
+#include <mutex>
+#include <semaphore>
+#include <functional>
+#include <atomic>
+
+namespace ECS
+{
+	// A fixed set of worker threads executing submitted tasks.
+	// Each worker owns a task queue: it pops its own tasks LIFO and steals from the other
+	// queues (FIFO) when it runs dry. Tasks submitted from a worker go to its own queue.
+	// The thread waiting on a ParallelFor helps executing tasks, so nested calls cannot starve the pool.
+	class ThreadPool
+	{
+	public:
+		/**
+		 * @brief Construct a new ThreadPool object.
+		 *
+		 * @param workerCount Number of worker threads. By default one per hardware thread,
+		 * minus the calling thread which takes part in ParallelFor.
+		 */
+		explicit ThreadPool(u32 workerCount = GetDefaultWorkerCount());
+
+		/**
+		 * @brief Destroy the ThreadPool object. Pending tasks are executed before the workers stop.
+		 */
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * @brief Get the number of worker threads.
+		 *
+		 * @return u32 Number of worker threads.
+		 */
+		u32 GetWorkerCount() const { return (u32)m_workers.size(); }
+
+		/**
+		 * @brief Queue a task to be executed by a worker thread.
+		 *
+		 * From a worker thread the task goes to that worker's queue, otherwise queues
+		 * are picked round-robin.
+		 *
+		 * @param task The task to execute.
+		 */
+		void Submit(std::function<void()> task);
+
+		/**
+		 * @brief Execute one queued task on the calling thread, if any.
+		 *	A worker thread looks in its own queue first, then steals from the others.
+		 *
+		 * @return true If a task was executed.
+		 * @return false If the queue was empty.
+		 */
+		bool RunPendingTask();
+
+		/**
+		 * @brief Split [0, count) in chunks of grainSize elements and execute them in parallel.
+		 *
+		 * Chunking is deterministic: chunk k always covers [k * grainSize, (k + 1) * grainSize).
+		 * Only the thread executing a chunk changes from one call to another.
+		 * Returns once every chunk has been executed.
+		 *
+		 * @tparam Func Callable taking (size_t begin, size_t end).
+		 * @param count Number of elements.
+		 * @param grainSize Number of elements per chunk.
+		 * @param func The function to execute on each chunk.
+		 */
+		template<typename Func> void ParallelFor(size_t count, size_t grainSize, Func&& func);
+
+		/**
+		 * @brief Get the default number of worker threads for this machine.
+		 *
+		 * @return u32 Hardware threads minus one (the calling thread).
+		 */
+		static u32 GetDefaultWorkerCount();
+
+	private:
+		struct TaskQueue
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		void WorkerLoop(u32 workerIndex);
+		bool PopTask(u32 queueIndex, std::function<void()>& task);
+		bool StealTask(u32 queueIndex, std::function<void()>& task);
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::vector<std::unique_ptr<TaskQueue>> m_queues; // One per worker (at least one)
+		std::atomic<u32> m_nextQueue = 0; // Round-robin queue for tasks submitted outside the pool
+		std::counting_semaphore<> m_pendingTasks{ 0 }; // Wakes one worker per submitted task
+		std::atomic<bool> m_stopping = false;
+	};
+
+	template<typename Func>
+	void ThreadPool::ParallelFor(size_t count, size_t grainSize, Func&& func)
+	{
+		if (count == 0)
+			return;
+
+		grainSize = std::max<size_t>(grainSize, 1);
+		const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+		// Nothing to share, run on the calling thread
+		if (chunkCount == 1 || m_workers.empty())
+		{
+			func((size_t)0, count);
+			return;
+		}
+
+		std::atomic<size_t> remaining = chunkCount - 1;
+		for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+		{
+			const size_t begin = chunk * grainSize;
+			const size_t end = std::min(begin + grainSize, count);
+
+			Submit([&func, &remaining, begin, end]() {
+				func(begin, end);
+				remaining.fetch_sub(1, std::memory_order_release);
+				});
+		}
+
+		// The calling thread takes the first chunk, then helps with the others
+		func((size_t)0, std::min(grainSize, count));
+
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			if (!RunPendingTask())
+				std::this_thread::yield();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+MIT License
+
+Copyright (c) 2026 Gatan Dezeiraud
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include "Common.h"
+#include "SoA.h"
+
+#include <tuple>
+
+namespace ECS
+{
+	template<typename T> class Pool;
+
+	// View arguments that do not require a component (see Registry::View()):
+	// View<Enemy, Exclude<Dead>, Optional<Target>>([](EntityID, Enemy&, Target*) {}) visits the
+	// entities that have an Enemy and no Dead, with a pointer to their Target (nullptr if they have none).
+	template<typename... Ts> struct Exclude {}; // Skip the entities having any of Ts, passes nothing to func
+	template<typename... Ts> struct Optional {}; // Pass a Ts* per type, nullptr if the entity does not have it
+
+	template<typename T>
+	struct ViewModifier
+	{
+		static constexpr bool exclude = false;
+		static constexpr bool optional = false;
+
+		template<typename Getter> static std::tuple<> GetPools(Getter&&) { return {}; }
+	};
+
+	template<typename... Ts>
+	struct ViewModifier<Exclude<Ts...>>
+	{
+		static constexpr bool exclude = true;
+		static constexpr bool optional = false;
+
+		template<typename Func> static void ForEachType(Func&& func) { (func.template operator()<Ts>(), ...); }
+		template<typename Getter> static std::tuple<> GetPools(Getter&&) { return {}; }
+	};
+
+	template<typename... Ts>
+	struct ViewModifier<Optional<Ts...>>
+	{
+		static constexpr bool exclude = false;
+		static constexpr bool optional = true;
+
+		// getter.operator()<T>() returns the Pool<T>* of the registry, nullptr if it has none
+		template<typename Getter> static std::tuple<Pool<Ts>*...> GetPools(Getter&& getter) { return { getter.template operator()<Ts>()... }; }
+
+		// getter.operator()<T>() returns the T* column of an archetype chunk, nullptr if it has none
+		template<typename Getter> static std::tuple<Ts*...> GetColumns(Getter&& getter) { return { getter.template operator()<Ts>()... }; }
+
+		// One pointer per type, nullptr if the entity does not have it
+		template<typename Pools> static std::tuple<Ts*...> GetArgs(const Pools& pools, EntityID entityId)
+		{
+			return { GetComponent(std::get<Pool<Ts>*>(pools), entityId)... };
+		}
+
+	private:
+		template<typename T> static T* GetComponent(Pool<T>* pool, EntityID entityId)
+		{
+			static_assert(!SoAComponent<T>, "SoA components can not be viewed as Optional<T>");
+			const int packedIndex = pool ? pool->GetPackedIndex(entityId) : -1;
+			return packedIndex == -1 ? nullptr : &(*pool)[(unsigned int)packedIndex];
+		}
+	};
+
+	template<typename T> constexpr bool IsViewModifier = ViewModifier<T>::exclude || ViewModifier<T>::optional;
+
+	// The view arguments that require a component (plain types and change filters), in order
+	template<typename... Ts>
+	using RequiredViewTerms = decltype(std::tuple_cat(std::declval<std::conditional_t<IsViewModifier<Ts>, std::tuple<>, std::tuple<Ts>>>()...));
+}
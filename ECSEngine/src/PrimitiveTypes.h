@@ -25,6 +25,7 @@ SOFTWARE.
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 
 // unsigned integers
 using u64 = uint64_t;
@@ -55,4 +56,15 @@ constexpr u32 HashString(const char* str)
 		hash *= 16777619u;
 	}
 	return hash;
+}
+
+constexpr u32 HashString(std::string_view str)
+{
+	u32 hash = 2166136261u;
+	for (char c : str)
+	{
+		hash ^= (u8)c;
+		hash *= 16777619u;
+	}
+	return hash;
 }
\ No newline at end of file
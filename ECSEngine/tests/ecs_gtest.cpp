@@ -23,12 +23,16 @@ SOFTWARE.
 */
 
 #include <gtest/gtest.h>
-#include <chrono>
 #include <numeric>
 #include <set>
 #include <memory>
 #include <algorithm>
 #include <random>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <sstream>
 
 #include "../src/ECS/ECS.h"
 #include "../src/PrimitiveTypes.h"
@@ -85,6 +89,41 @@ TEST(ECSTest, EntityTagAndGroup) {
 	EXPECT_EQ(groupEntities[0], entity);
 }
 
+TEST(ECSTest, TagAndGroupNamesAreHashedAtCompileTime) {
+	using namespace ECS;
+	static constexpr Name Enemies{ "enemies" };
+	static_assert(Enemies.GetHash() == HashString("enemies"));
+
+	Registry registry;
+	auto a = registry.CreateEntity();
+	auto b = registry.CreateEntity();
+	auto c = registry.CreateEntity();
+
+	// A tag follows the last tagged entity, an entity keeps its last tag
+	a.Tag("player");
+	b.Tag("player");
+	EXPECT_FALSE(a.HasTag("player"));
+	EXPECT_EQ(registry.GetEntityByTag("player"), b);
+	b.Tag("boss");
+	EXPECT_FALSE(b.HasTag("player"));
+	EXPECT_TRUE(b.HasTag("boss"));
+
+	EXPECT_TRUE(registry.GetEntitiesByGroup(Enemies).empty());
+	a.Group(Enemies);
+	b.Group(Enemies);
+	c.Group(Enemies);
+	c.Group(Enemies);
+	EXPECT_EQ(registry.GetEntitiesByGroup(Enemies).size(), 3);
+
+	registry.KillEntity(a);
+	registry.Update();
+	auto members = registry.GetEntitiesByGroup(Enemies);
+	EXPECT_EQ(members.size(), 2);
+	EXPECT_TRUE(b.BelongsToGroup(Enemies));
+	EXPECT_TRUE(c.BelongsToGroup("enemies"));
+	EXPECT_TRUE(std::find(members.begin(), members.end(), a) == members.end());
+}
+
 TEST(ECSTest, StressTest_MassEntityCreation) {
 	using namespace ECS;
 	Registry registry;
@@ -112,7 +151,7 @@ TEST(ECSTest, StressTest_MassEntityCreation) {
 	}
 }
 
-// Suggestion: Add a performance test for component access
+// Timings for these access patterns live in the ECSEngineBench suite
 TEST(ECSTest, ComponentAccessPerformance) {
 	using namespace ECS;
 	Registry registry;
@@ -126,23 +165,16 @@ TEST(ECSTest, ComponentAccessPerformance) {
 		entities.push_back(e);
 	}
 
-	// Time component access
-	auto start = std::chrono::high_resolution_clock::now();
 	int sum = 0;
 	for (size_t i = 0; i < N; ++i) {
 		sum += registry.GetComponent<TestComponent>(entities[i]).value;
 	}
-	auto end = std::chrono::high_resolution_clock::now();
-	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 
 	int expected_sum = 0;
 	for (size_t i = 0; i < N; ++i) {
 		expected_sum += static_cast<int>(i);
 	}
 	EXPECT_EQ(sum, expected_sum);
-
-	// Print timing for informational purposes
-	std::cout << "[          ] Component access time: " << ms << " ms\n";
 }
 
 TEST(ECSTest, ComponentAccessPerformance_Random) {
@@ -162,19 +194,12 @@ TEST(ECSTest, ComponentAccessPerformance_Random) {
 	std::mt19937 g(rd());
 	std::shuffle(entities.begin(), entities.end(), g);
 
-	auto start = std::chrono::high_resolution_clock::now();
-
 	long long sum = 0;
 	for (size_t i = 0; i < N; ++i) {
 		sum += registry.GetComponent<TestComponent>(entities[i]).value;
 	}
 
-	auto end = std::chrono::high_resolution_clock::now();
-	auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-
 	EXPECT_GT(sum, 0);
-
-	std::cout << "[          ] Random access time (100k): " << ms << " ms\n";
 }
 
 // Test: Entity Reuse and ID Recycling
@@ -304,3 +329,1438 @@ TEST(ECSTest, ViewIteratesMatchingEntities) {
 	// Expect 3 matches for N=5 (indices 0,2,4)
 	EXPECT_EQ(matchedCount, 3);
 }
+
+TEST(ECSTest, ViewLeaderIsSmallestPool) {
+	using namespace ECS;
+	Registry registry;
+
+	struct RareComponent { int id; RareComponent(int v = 0) : id(v) {} };
+
+	constexpr int N = 1000;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		registry.AddComponent<TestComponent>(e, i);
+		if ((i % 100) == 0) {
+			registry.AddComponent<RareComponent>(e, i);
+		}
+	}
+
+	// Both orders must visit the same entities and pass components in the declared order
+	int commonFirst = 0;
+	registry.View<TestComponent, RareComponent>([&](EntityID, TestComponent& tc, RareComponent& rc) {
+		++commonFirst;
+		EXPECT_EQ(tc.value, rc.id);
+		});
+
+	int rareFirst = 0;
+	registry.View<RareComponent, TestComponent>([&](EntityID, RareComponent& rc, TestComponent& tc) {
+		++rareFirst;
+		EXPECT_EQ(tc.value, rc.id);
+		});
+
+	EXPECT_EQ(commonFirst, N / 100);
+	EXPECT_EQ(rareFirst, N / 100);
+}
+
+TEST(ECSTest, OwningGroupKeepsMatchingEntitiesPacked) {
+	using namespace ECS;
+	Registry registry;
+
+	struct Transform { int x; Transform(int v = 0) : x(v) {} };
+	struct Velocity { int dx; Velocity(int v = 0) : dx(v) {} };
+
+	constexpr int N = 100;
+	std::vector<Entity> entities;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		registry.AddComponent<Transform>(e, i);
+		if ((i % 2) == 0) {
+			registry.AddComponent<Velocity>(e, i);
+		}
+	}
+
+	// Declaring the group packs the entities that already match
+	OwningGroup& group = registry.OwnGroup<Transform, Velocity>();
+	EXPECT_EQ(group.GetSize(), N / 2);
+	OwningGroup& sameGroup = registry.OwnGroup<Transform, Velocity>();
+	EXPECT_EQ(&group, &sameGroup);
+
+	// Add/Remove keep the group range up to date
+	registry.AddComponent<Velocity>(entities[1], 1);
+	EXPECT_EQ(group.GetSize(), N / 2 + 1);
+	registry.RemoveComponent<Transform>(entities[0]);
+	EXPECT_EQ(group.GetSize(), N / 2);
+	registry.KillEntity(entities[2]);
+	registry.Update();
+	EXPECT_EQ(group.GetSize(), N / 2 - 1);
+
+	int matchedCount = 0;
+	registry.View<Transform, Velocity>([&](EntityID id, Transform& t, Velocity& v) {
+		++matchedCount;
+		EXPECT_EQ(t.x, v.dx);
+		EXPECT_TRUE(registry.HasComponent<Transform>(Entity(id)));
+		EXPECT_TRUE(registry.HasComponent<Velocity>(Entity(id)));
+		});
+	EXPECT_EQ(matchedCount, N / 2 - 1);
+}
+
+TEST(ECSTest, ParallelViewVisitsEachEntityOnce) {
+	using namespace ECS;
+	Registry registry;
+	registry.SetThreadPool(std::make_shared<ThreadPool>(4));
+
+	struct Counter { int visits = 0; };
+
+	constexpr int N = 10000;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		registry.AddComponent<TestComponent>(e, i);
+		if ((i % 3) == 0) {
+			registry.AddComponent<Counter>(e);
+		}
+	}
+
+	std::atomic<int> matchedCount = 0;
+	registry.ParallelView<TestComponent, Counter>([&](EntityID, TestComponent&, Counter& c) {
+		++c.visits;
+		++matchedCount;
+		}, 64);
+
+	EXPECT_EQ(matchedCount.load(), (N + 2) / 3);
+	registry.View<Counter>([&](EntityID, Counter& c) {
+		EXPECT_EQ(c.visits, 1);
+		});
+}
+
+namespace
+{
+	struct PositionComponent { int x = 0; };
+	struct VelocityComponent { int dx = 0; };
+
+	struct IntegrateSystem : ECS::System
+	{
+		IntegrateSystem() { WriteComponent<PositionComponent>(); ReadComponent<VelocityComponent>(); }
+		void Update(f32) override {
+			for (auto e : GetSystemEntities())
+				e.GetComponent<PositionComponent>().x += e.GetComponent<VelocityComponent>().dx;
+		}
+	};
+
+	struct ReadPositionSystem : ECS::System
+	{
+		int sum = 0;
+		ReadPositionSystem() { ReadComponent<PositionComponent>(); }
+		void Update(f32) override {
+			for (auto e : GetSystemEntities())
+				sum += e.GetComponent<PositionComponent>().x;
+		}
+	};
+
+	struct ReadVelocitySystem : ECS::System
+	{
+		int sum = 0;
+		ReadVelocitySystem() { ReadComponent<VelocityComponent>(); }
+		void Update(f32) override {
+			for (auto e : GetSystemEntities())
+				sum += e.GetComponent<VelocityComponent>().dx;
+		}
+	};
+}
+
+TEST(ECSTest, RunSystemsOrdersConflictingSystems) {
+	using namespace ECS;
+	Registry registry;
+	registry.SetThreadPool(std::make_shared<ThreadPool>(4));
+
+	registry.AddSystem<IntegrateSystem>();
+	registry.AddSystem<ReadPositionSystem>();
+	registry.AddSystem<ReadVelocitySystem>();
+
+	EXPECT_TRUE(registry.GetSystem<IntegrateSystem>().ConflictsWith(registry.GetSystem<ReadPositionSystem>()));
+	EXPECT_FALSE(registry.GetSystem<ReadPositionSystem>().ConflictsWith(registry.GetSystem<ReadVelocitySystem>()));
+
+	constexpr int N = 100;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		registry.AddComponent<PositionComponent>(e);
+		registry.AddComponent<VelocityComponent>(e, VelocityComponent{ 1 });
+	}
+	registry.Update();
+
+	// ReadPositionSystem must see the positions written by IntegrateSystem in the same frame
+	for (int frame = 1; frame <= 10; ++frame) {
+		auto& reader = registry.GetSystem<ReadPositionSystem>();
+		reader.sum = 0;
+		registry.RunSystems(1.0f);
+		EXPECT_EQ(reader.sum, N * frame);
+	}
+	EXPECT_EQ(registry.GetSystem<ReadVelocitySystem>().sum, N * 10);
+}
+
+TEST(ECSTest, SystemMembershipRemoval) {
+	using namespace ECS;
+	Registry registry;
+
+	struct CountingSystem : System
+	{
+		int removed = 0;
+		CountingSystem() { RequireComponent<PositionComponent>(); }
+		void Remove(Entity) override { ++removed; }
+	};
+	struct EverySystem : System
+	{
+		int removed = 0;
+		void Remove(Entity) override { ++removed; }
+	};
+	registry.AddSystem<CountingSystem>();
+	registry.AddSystem<EverySystem>();
+
+	constexpr int N = 1000;
+	std::vector<Entity> entities;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		if ((i % 2) == 0) {
+			registry.AddComponent<PositionComponent>(e);
+		}
+	}
+	registry.Update();
+
+	auto& system = registry.GetSystem<CountingSystem>();
+	EXPECT_EQ(system.GetSystemEntities().size(), N / 2);
+
+	// Kill every entity: only members trigger the Remove callback
+	for (auto& e : entities) {
+		registry.KillEntity(e);
+	}
+	registry.Update();
+
+	EXPECT_EQ(system.removed, N / 2);
+	EXPECT_TRUE(system.GetSystemEntities().empty());
+	EXPECT_EQ(registry.GetSystem<EverySystem>().removed, N);
+	EXPECT_TRUE(registry.GetSystem<EverySystem>().GetSystemEntities().empty());
+
+	// Recycled indices with a new version are not confused with the killed entities
+	auto recycled = registry.CreateEntity();
+	registry.AddComponent<PositionComponent>(recycled);
+	registry.Update();
+	EXPECT_TRUE(system.HasEntity(recycled));
+	EXPECT_FALSE(system.HasEntity(entities[GetEntityIndex(recycled.GetId())]));
+	EXPECT_TRUE(registry.HasComponent<PositionComponent>(recycled));
+}
+
+TEST(ECSTest, BatchedEntityCreationAndDestruction) {
+	using namespace ECS;
+	Registry registry;
+
+	constexpr size_t N = 1000;
+	std::vector<Entity> entities(N);
+	registry.CreateEntities(N, entities);
+
+	std::set<EntityID> uniqueIds;
+	for (const auto& e : entities) {
+		EXPECT_TRUE(registry.IsValid(e));
+		uniqueIds.insert(e.GetId());
+	}
+	EXPECT_EQ(uniqueIds.size(), N);
+
+	std::vector<TestComponent> values;
+	for (size_t i = 0; i < N; ++i) {
+		values.emplace_back((int)i);
+	}
+	registry.AddComponents<TestComponent>(entities, values);
+	registry.Update();
+
+	for (size_t i = 0; i < N; ++i) {
+		EXPECT_EQ(registry.GetComponent<TestComponent>(entities[i]).value, (int)i);
+	}
+
+	// Kill the first half, the same entity twice is harmless
+	registry.KillEntities(std::span<const Entity>(entities.data(), N / 2));
+	registry.KillEntity(entities[0]);
+	registry.Update();
+
+	for (size_t i = 0; i < N; ++i) {
+		EXPECT_EQ(registry.IsValid(entities[i]), i >= N / 2);
+	}
+
+	// Batches mixing recycled and new indices
+	std::vector<Entity> recycled(N);
+	registry.CreateEntities(N, recycled);
+	std::set<u32> indices;
+	for (const auto& e : recycled) {
+		EXPECT_TRUE(registry.IsValid(e));
+		EXPECT_FALSE(registry.HasComponent<TestComponent>(e));
+		indices.insert(GetEntityIndex(e.GetId()));
+	}
+	EXPECT_EQ(indices.size(), N);
+	EXPECT_EQ(*indices.rbegin(), N + N / 2 - 1);
+}
+
+TEST(ECSTest, KillEntityRemovesOnlyOwnedComponents) {
+	using namespace ECS;
+	Registry registry;
+
+	struct OtherComponent { int x = 0; };
+
+	auto a = registry.CreateEntity();
+	auto b = registry.CreateEntity();
+	auto c = registry.CreateEntity();
+	registry.AddComponent<TestComponent>(a, 1);
+	registry.AddComponent<TestComponent>(b, 2);
+	registry.AddComponent<OtherComponent>(b);
+	registry.AddComponent<OtherComponent>(c);
+	registry.Update();
+
+	registry.KillEntity(a);
+	registry.KillEntity(b);
+	registry.Update();
+
+	int testCount = 0;
+	registry.View<TestComponent>([&](EntityID, TestComponent&) { ++testCount; });
+	int otherCount = 0;
+	registry.View<OtherComponent>([&](EntityID id, OtherComponent&) {
+		++otherCount;
+		EXPECT_EQ(id, c.GetId());
+		});
+	EXPECT_EQ(testCount, 0);
+	EXPECT_EQ(otherCount, 1);
+
+	// The recycled index starts with an empty signature
+	auto recycled = registry.CreateEntity();
+	EXPECT_FALSE(registry.HasComponent<TestComponent>(recycled));
+	EXPECT_FALSE(registry.HasComponent<OtherComponent>(recycled));
+}
+
+TEST(ECSTest, SignatureOperations) {
+	using namespace ECS;
+	BasicSignature<256> entity;
+	BasicSignature<256> system;
+
+	entity.set(3).set(70).set(200);
+	system.set(70).set(200);
+	EXPECT_TRUE(entity.Contains(system));
+	EXPECT_EQ(entity & system, system);
+	EXPECT_TRUE(entity.Intersects(system));
+	EXPECT_EQ(entity.count(), 3);
+
+	system.set(255);
+	EXPECT_FALSE(entity.Contains(system));
+
+	std::vector<u32> bits;
+	entity.ForEachSetBit([&](u32 bit) { bits.push_back(bit); });
+	EXPECT_EQ(bits, (std::vector<u32>{ 3, 70, 200 }));
+
+	entity.set(70, false);
+	EXPECT_FALSE(entity.test(70));
+	entity.reset();
+	EXPECT_TRUE(entity.none());
+}
+
+TEST(ECSTest, SparsePagesAreReleasedAndRecycled) {
+	using namespace ECS;
+	PageAllocator allocator;
+
+	{
+		SparseIndex sparse(64, allocator);
+		sparse.Set(5, 1);
+		sparse.Set(6, 2);
+		sparse.Set(70, 3);
+		EXPECT_EQ(sparse.GetAllocatedPageCount(), 2);
+		EXPECT_EQ(sparse.Get(70), 3);
+		EXPECT_EQ(sparse.Get(71), u32_invalid_id);
+		EXPECT_EQ(sparse.Get(100000), u32_invalid_id);
+
+		// The page is released once its last entry is removed, kept by the index as its spare
+		sparse.Reset(5);
+		EXPECT_EQ(sparse.GetAllocatedPageCount(), 2);
+		sparse.Reset(6);
+		EXPECT_EQ(sparse.GetAllocatedPageCount(), 1);
+		EXPECT_TRUE(sparse.HasSparePage());
+		EXPECT_EQ(allocator.GetCachedPageCount(), 0);
+
+		// And is reused by the next page allocation, cleared, without going through the allocator
+		sparse.Set(200, 4);
+		EXPECT_FALSE(sparse.HasSparePage());
+		EXPECT_EQ(sparse.Get(200 - 64), u32_invalid_id);
+
+		// Churn on a single entity keeps reusing the spare
+		for (int i = 0; i < 10; ++i) {
+			sparse.Set(300, 5);
+			sparse.Reset(300);
+		}
+		EXPECT_TRUE(sparse.HasSparePage());
+		EXPECT_EQ(allocator.GetCachedPageCount(), 0);
+
+		// Further released pages go to the allocator cache
+		sparse.Reset(70);
+		EXPECT_EQ(allocator.GetCachedPageCount(), 1);
+		sparse.ShrinkToFit();
+		EXPECT_EQ(allocator.GetCachedPageCount(), 2);
+		sparse.Set(1000, 6);
+		EXPECT_EQ(allocator.GetCachedPageCount(), 1);
+	}
+	EXPECT_EQ(allocator.GetCachedPageCount(), 3);
+
+	// Trimming frees the cache down to the requested number of pages
+	allocator.Trim(1);
+	EXPECT_EQ(allocator.GetCachedPageCount(), 1);
+	allocator.Trim();
+	EXPECT_EQ(allocator.GetCachedPageCount(), 0);
+}
+
+TEST(ECSTest, PoolPageSizeIsTunable) {
+	using namespace ECS;
+	Registry registry;
+	registry.SetPoolPageSize<TestComponent>(16);
+
+	constexpr int N = 100;
+	std::vector<Entity> entities;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		registry.AddComponent<TestComponent>(e, i);
+	}
+
+	for (int i = 0; i < N; i += 3) {
+		registry.RemoveComponent<TestComponent>(entities[i]);
+	}
+	for (int i = 0; i < N; ++i) {
+		EXPECT_EQ(registry.HasComponent<TestComponent>(entities[i]), (i % 3) != 0);
+		if (i % 3) {
+			EXPECT_EQ(registry.GetComponent<TestComponent>(entities[i]).value, i);
+		}
+	}
+}
+
+TEST(ECSTest, ArchetypeStorageMovesEntitiesBetweenArchetypes) {
+	using namespace ECS;
+	struct Name { std::string value; };
+	struct Speed { int value = 0; };
+
+	Registry registry(StorageMode::Archetype);
+	EXPECT_EQ(registry.GetStorageMode(), StorageMode::Archetype);
+
+	// Enough entities to span several chunks
+	constexpr int N = 3000;
+	std::vector<Entity> entities;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		registry.AddComponent<TestComponent>(e, i);
+		registry.AddComponent<Name>(e, std::to_string(i));
+		if (i % 2)
+			registry.AddComponent<Speed>(e, i);
+	}
+	registry.Update();
+
+	// Components follow their entity when it changes archetype
+	for (int i = 0; i < N; i += 3)
+		registry.RemoveComponent<TestComponent>(entities[i]);
+	for (int i = 0; i < N; ++i) {
+		EXPECT_EQ(registry.HasComponent<TestComponent>(entities[i]), (i % 3) != 0);
+		EXPECT_EQ(registry.GetComponent<Name>(entities[i]).value, std::to_string(i));
+	}
+
+	int visited = 0;
+	registry.View<const Name, Speed>([&](EntityID id, const Name& name, Speed& speed) {
+		EXPECT_EQ(name.value, std::to_string(speed.value));
+		EXPECT_EQ((int)GetEntityIndex(id), speed.value);
+		++visited;
+		});
+	EXPECT_EQ(visited, N / 2);
+
+	for (int i = 0; i < N; i += 2)
+		registry.KillEntity(entities[i]);
+	registry.Update();
+
+	visited = 0;
+	registry.View<Name>([&](EntityID, Name&) { ++visited; });
+	EXPECT_EQ(visited, N / 2);
+
+	// Change filters are not kept by archetypes, refused in every build
+	EXPECT_DEATH(registry.View<Changed<Name>>([](EntityID, Name&) {}), "StorageMode::SparseSet");
+	EXPECT_DEATH(registry.EnableChangeTracking<Name>(), "StorageMode::SparseSet");
+}
+
+TEST(ECSTest, ForEachChunkHandsAlignedSpans) {
+	using namespace ECS;
+	struct Position { float x = 0.0f; };
+	struct Velocity { float dx = 1.0f; };
+
+	auto isAligned = [](const void* data) { return reinterpret_cast<uintptr_t>(data) % CACHE_LINE_SIZE == 0; };
+
+	for (StorageMode mode : { StorageMode::SparseSet, StorageMode::Archetype }) {
+		Registry registry(mode);
+		if (mode == StorageMode::SparseSet)
+			registry.OwnGroup<Position, Velocity>();
+
+		constexpr int N = 5000;
+		for (int i = 0; i < N; ++i) {
+			auto e = registry.CreateEntity();
+			registry.AddComponent<Position>(e);
+			if (i % 4)
+				registry.AddComponent<Velocity>(e);
+		}
+		registry.Update();
+
+		size_t visited = 0;
+		registry.ForEachChunk<Position, Velocity>([&](std::span<const EntityID> entities, std::span<Position> positions, std::span<Velocity> velocities) {
+			EXPECT_EQ(entities.size(), positions.size());
+			EXPECT_EQ(entities.size(), velocities.size());
+			EXPECT_TRUE(isAligned(positions.data()));
+			EXPECT_TRUE(isAligned(velocities.data()));
+			for (size_t i = 0; i < positions.size(); ++i)
+				positions[i].x += velocities[i].dx;
+			visited += entities.size();
+			});
+		EXPECT_EQ(visited, (size_t)(N - N / 4));
+
+		float total = 0.0f;
+		registry.View<Position>([&](EntityID, Position& p) { total += p.x; });
+		EXPECT_EQ(total, (float)(N - N / 4));
+	}
+
+	// Without an owning group the batches are gathered, and the writes moved back
+	Registry registry;
+	constexpr int N = 3000;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		if (i % 3)
+			registry.AddComponent<Velocity>(e);
+		registry.AddComponent<Position>(e);
+	}
+	registry.Update();
+
+	size_t visited = 0;
+	registry.ForEachChunk<Position, Velocity>([&](std::span<const EntityID> entities, std::span<Position> positions, std::span<Velocity> velocities) {
+		EXPECT_LE(entities.size(), CHUNK_BATCH_SIZE);
+		EXPECT_TRUE(isAligned(positions.data()));
+		EXPECT_TRUE(isAligned(velocities.data()));
+		for (size_t i = 0; i < positions.size(); ++i)
+			positions[i].x = (float)GetEntityIndex(entities[i]);
+		visited += entities.size();
+		});
+	EXPECT_EQ(visited, (size_t)(N - N / 3));
+
+	registry.View<Position>([&](EntityID id, Position& p) { EXPECT_EQ(p.x, GetEntityIndex(id) % 3 ? (float)GetEntityIndex(id) : 0.0f); });
+}
+
+struct SoATransform
+{
+	float x = 0.0f, y = 0.0f;
+	int layer = 0;
+};
+
+template<> struct ECS::SoALayout<SoATransform>
+{
+	static constexpr auto fields = std::make_tuple(&SoATransform::x, &SoATransform::y, &SoATransform::layer);
+};
+
+TEST(ECSTest, SoAPoolStoresFieldsSeparately) {
+	using namespace ECS;
+	static_assert(SoAComponent<SoATransform>);
+	static_assert(!SoAComponent<TestComponent>);
+
+	Registry registry;
+	constexpr int N = 2500;
+	std::vector<Entity> entities;
+	for (int i = 0; i < N; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		registry.AddComponent<SoATransform>(e, SoATransform{ (float)i, 0.0f, i % 3 });
+	}
+	registry.RemoveComponent<SoATransform>(entities[0]);
+
+	// Proxies read and write straight into the field arrays
+	SoARef<SoATransform> transform = registry.GetComponent<SoATransform>(entities[10]);
+	EXPECT_EQ(transform.Get<&SoATransform::x>(), 10.0f);
+	transform.Get<&SoATransform::y>() = 5.0f;
+	EXPECT_EQ(((SoATransform)registry.GetComponent<SoATransform>(entities[10])).y, 5.0f);
+
+	registry.View<SoATransform>([](EntityID, SoARef<SoATransform> t) {
+		t.Get<&SoATransform::y>() += t.Get<&SoATransform::x>();
+		});
+
+	size_t visited = 0;
+	registry.ForEachField<SoATransform, &SoATransform::x, &SoATransform::y>([&](std::span<const EntityID> ids, std::span<float> xs, std::span<float> ys) {
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(xs.data()) % CACHE_LINE_SIZE, 0u);
+		for (size_t i = 0; i < ids.size(); ++i)
+			EXPECT_EQ(ys[i], xs[i] + (GetEntityIndex(ids[i]) == 10 ? 5.0f : 0.0f));
+		visited += ids.size();
+		});
+	EXPECT_EQ(visited, (size_t)N - 1);
+
+	// Read-only access gathers a copy
+	EXPECT_EQ(registry.GetConstComponent<SoATransform>(entities[10]).y, 15.0f);
+	float layers = 0.0f;
+	registry.View<const SoATransform>([&](EntityID, const SoATransform& t) { layers += (float)t.layer; });
+	EXPECT_EQ(layers, (float)(N - 1));
+}
+
+struct StaticIdComponent { int value = 0; };
+ECS_STATIC_COMPONENT_ID(StaticIdComponent, 3);
+
+TEST(ECSTest, CompileTimeComponentIds) {
+	using namespace ECS;
+
+	// Folded at compile time, and outside the runtime id range
+	static_assert(Component<StaticIdComponent>::GetId() == 3);
+	EXPECT_GE(Component<TestComponent>::GetId(), STATIC_COMPONENT_IDS);
+
+	static_assert(Component<StaticIdComponent>::GetTypeName() == "StaticIdComponent");
+	static_assert(Component<StaticIdComponent>::GetTypeHash() != Component<TestComponent>::GetTypeHash());
+
+	Registry registry;
+	auto e = registry.CreateEntity();
+	registry.AddComponent<StaticIdComponent>(e, 7);
+	registry.AddComponent<TestComponent>(e, 1);
+	EXPECT_TRUE(registry.HasComponent<StaticIdComponent>(e));
+	EXPECT_EQ(registry.GetComponent<StaticIdComponent>(e).value, 7);
+}
+
+TEST(ECSTest, PersistentQueryTracksSignatureChanges) {
+	using namespace ECS;
+	struct Position { int x = 0; };
+	struct Velocity { int dx = 1; };
+
+	for (StorageMode mode : { StorageMode::SparseSet, StorageMode::Archetype }) {
+		Registry registry(mode);
+
+		std::vector<Entity> entities;
+		for (int i = 0; i < 10; ++i) {
+			auto e = registry.CreateEntity();
+			entities.push_back(e);
+			registry.AddComponent<Position>(e, i);
+			if (i < 5)
+				registry.AddComponent<Velocity>(e);
+		}
+
+		// Existing entities are picked up at creation, the state is shared
+		auto query = registry.CreateQuery<Position, Velocity>();
+		EXPECT_EQ(query.GetSize(), 5u);
+		auto sameQuery = registry.CreateQuery<Position, Velocity>();
+		EXPECT_EQ(&sameQuery.GetEntities(), &query.GetEntities());
+
+		registry.AddComponent<Velocity>(entities[7]);
+		registry.RemoveComponent<Velocity>(entities[0]);
+		registry.RemoveComponent<Position>(entities[1]);
+		EXPECT_TRUE(query.Contains(entities[7]));
+		EXPECT_FALSE(query.Contains(entities[0]));
+		EXPECT_FALSE(query.Contains(entities[1]));
+		EXPECT_EQ(query.GetSize(), 4u);
+
+		registry.KillEntity(entities[2]);
+		registry.Update();
+		EXPECT_EQ(query.GetSize(), 3u);
+
+		std::set<int> visited;
+		query.Each([&](EntityID, Position& p, Velocity& v) {
+			p.x += v.dx;
+			visited.insert(p.x);
+			});
+		EXPECT_EQ(visited, (std::set<int>{ 4, 5, 8 }));
+	}
+}
+
+TEST(ECSTest, SystemMembershipFollowsComponentChanges) {
+	using namespace ECS;
+	Registry registry;
+
+	struct MovementSystem : System
+	{
+		int added = 0, removed = 0;
+		MovementSystem() { RequireComponent<PositionComponent>(); RequireComponent<VelocityComponent>(); }
+		void Add(Entity) override { ++added; }
+		void Remove(Entity) override { ++removed; }
+	};
+	registry.AddSystem<MovementSystem>();
+	auto& system = registry.GetSystem<MovementSystem>();
+
+	auto a = registry.CreateEntity();
+	auto b = registry.CreateEntity();
+	registry.AddComponent<PositionComponent>(a);
+	registry.AddComponent<PositionComponent>(b);
+	registry.Update();
+	EXPECT_TRUE(system.GetSystemEntities().empty());
+
+	// Live entities join and leave at the next Update
+	registry.AddComponent<VelocityComponent>(a);
+	registry.AddComponent<VelocityComponent>(b);
+	EXPECT_FALSE(system.HasEntity(a));
+	registry.Update();
+	EXPECT_TRUE(system.HasEntity(a));
+	EXPECT_TRUE(system.HasEntity(b));
+
+	registry.RemoveComponent<PositionComponent>(a);
+	registry.RemoveComponent<VelocityComponent>(b);
+	registry.AddComponent<VelocityComponent>(b); // Back to the synced signature
+	registry.Update();
+	EXPECT_FALSE(system.HasEntity(a));
+	EXPECT_TRUE(system.HasEntity(b));
+	EXPECT_EQ(system.added, 2);
+	EXPECT_EQ(system.removed, 1);
+}
+
+TEST(ECSTest, KilledEntitiesAreRemovedFromPoolsInOneBatch) {
+	using namespace ECS;
+	struct Flag {};
+	Registry registry;
+	registry.EnableChangeTracking<PositionComponent>();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 200; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		registry.AddComponent<PositionComponent>(e, PositionComponent{ i });
+		registry.AddComponent<SoATransform>(e, SoATransform{ (float)i, 0.0f, i });
+		registry.AddComponent<Flag>(e);
+	}
+	registry.Update();
+	for (int i = 1; i < 200; i += 10)
+		registry.MarkChanged<PositionComponent>(entities[i]);
+
+	// Holes before the new size and kills in the tail, one entity queued twice
+	std::vector<Entity> killed;
+	for (int i = 0; i < 200; ++i)
+		if (i % 3 == 0 || i >= 150)
+			killed.push_back(entities[i]);
+	killed.push_back(entities[3]);
+	registry.KillEntities(killed);
+	registry.Update();
+
+	int changed = 0;
+	registry.ViewSince<Changed<PositionComponent>>(registry.GetTick() - 1, [&](EntityID, PositionComponent& p) {
+		EXPECT_EQ(p.x % 10, 1);
+		changed++;
+		});
+	EXPECT_EQ(changed, 10);
+
+	int alive = 0;
+	registry.View<PositionComponent, SoATransform, Flag>([&](EntityID id, PositionComponent& p, SoARef<SoATransform> t, Flag&) {
+		EXPECT_EQ((int)GetEntityIndex(id), p.x);
+		EXPECT_EQ(t.Get<&SoATransform::layer>(), p.x);
+		EXPECT_TRUE(p.x % 3 != 0 && p.x < 150);
+		alive++;
+		});
+	EXPECT_EQ(alive, 100);
+	for (const PoolStats& pool : registry.GetPoolStats())
+		EXPECT_EQ(pool.size, 100u);
+	EXPECT_EQ(registry.GetFreeEntityCount(), 100u);
+}
+
+TEST(ECSTest, ChangeDetectionFilters) {
+	using namespace ECS;
+	Registry registry;
+	registry.EnableChangeTracking<PositionComponent>();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		registry.AddComponent<PositionComponent>(e);
+		registry.AddComponent<VelocityComponent>(e);
+	}
+
+	auto count = [&](auto&& view) { int n = 0; view([&n](auto&&...) { ++n; }); return n; };
+
+	EXPECT_EQ(count([&](auto f) { registry.View<Added<PositionComponent>>(f); }), 10);
+	registry.Update();
+
+	// Nothing touched during this frame
+	EXPECT_EQ(count([&](auto f) { registry.View<Changed<PositionComponent>, VelocityComponent>(f); }), 0);
+
+	registry.GetMutableComponent<PositionComponent>(entities[1]).x = 5;
+	registry.MarkChanged<PositionComponent>(entities[2]);
+	registry.RemoveComponent<PositionComponent>(entities[3]);
+	registry.RemoveComponent<PositionComponent>(entities[4]);
+	registry.AddComponent<PositionComponent>(entities[4]);
+
+	std::set<EntityID> changed;
+	registry.View<Changed<PositionComponent>, VelocityComponent>([&](EntityID id, PositionComponent&, VelocityComponent&) { changed.insert(id); });
+	EXPECT_EQ(changed, (std::set<EntityID>{ entities[1].GetId(), entities[2].GetId(), entities[4].GetId() }));
+	EXPECT_EQ(count([&](auto f) { registry.View<Added<PositionComponent>>(f); }), 1);
+	EXPECT_EQ(count([&](auto f) { registry.View<Removed<PositionComponent>>(f); }), 2);
+
+	// Removals of the previous frame stay visible for one more frame
+	registry.Update();
+	EXPECT_EQ(count([&](auto f) { registry.View<Removed<PositionComponent>>(f); }), 0);
+	EXPECT_EQ(count([&](auto f) { registry.ViewSince<Removed<PositionComponent>>(registry.GetTick() - 1, f); }), 2);
+	EXPECT_EQ(count([&](auto f) { registry.ViewSince<Changed<PositionComponent>>(registry.GetTick() - 1, f); }), 3);
+	registry.Update();
+	EXPECT_EQ(count([&](auto f) { registry.ViewSince<Removed<PositionComponent>>(registry.GetTick() - 1, f); }), 0);
+}
+
+TEST(ECSTest, ComponentObserversAreBatched) {
+	using namespace ECS;
+	Registry registry;
+
+	std::vector<std::vector<EntityID>> constructed, updated, destroyed;
+	registry.OnConstruct<PositionComponent>([&](std::span<const EntityID> ids) { constructed.emplace_back(ids.begin(), ids.end()); });
+	registry.OnUpdate<PositionComponent>([&](std::span<const EntityID> ids) { updated.emplace_back(ids.begin(), ids.end()); });
+	registry.OnDestroy<PositionComponent>([&](std::span<const EntityID> ids) { destroyed.emplace_back(ids.begin(), ids.end()); });
+
+	auto a = registry.CreateEntity();
+	auto b = registry.CreateEntity();
+	registry.AddComponent<PositionComponent>(a);
+	registry.AddComponent<PositionComponent>(b);
+	registry.AddComponent<VelocityComponent>(b);
+	EXPECT_TRUE(constructed.empty()); // Nothing before Update
+	registry.Update();
+	ASSERT_EQ(constructed.size(), 1u);
+	EXPECT_EQ(constructed[0], (std::vector<EntityID>{ a.GetId(), b.GetId() }));
+
+	registry.ReplaceComponent<PositionComponent>(a, PositionComponent{ 3 });
+	registry.MarkChanged<PositionComponent>(a);
+	registry.RemoveComponent<PositionComponent>(a);
+	registry.KillEntity(b);
+	registry.Update();
+	EXPECT_EQ(registry.HasComponent<PositionComponent>(a), false);
+	ASSERT_EQ(updated.size(), 1u);
+	EXPECT_EQ(updated[0], (std::vector<EntityID>{ a.GetId() }));
+	ASSERT_EQ(destroyed.size(), 1u);
+	EXPECT_EQ(destroyed[0], (std::vector<EntityID>{ a.GetId(), b.GetId() }));
+
+	// No event, no call
+	registry.Update();
+	EXPECT_EQ(constructed.size() + updated.size() + destroyed.size(), 3u);
+}
+
+TEST(ECSTest, CommandBuffersPlayBackInOrder) {
+	using namespace ECS;
+	Registry registry;
+	registry.SetThreadPool(std::make_shared<ThreadPool>(4));
+
+	std::vector<Entity> targets;
+	for (int i = 0; i < 4; ++i) {
+		auto e = registry.CreateEntity();
+		targets.push_back(e);
+		registry.AddComponent<PositionComponent>(e);
+	}
+	registry.Update();
+
+	constexpr size_t Buffers = 4;
+	std::vector<CommandBuffer*> buffers;
+	for (size_t i = 0; i < Buffers; ++i)
+		buffers.push_back(&registry.CreateCommandBuffer());
+
+	// Each task records into its own buffer
+	registry.GetThreadPool().ParallelFor(Buffers, 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			CommandBuffer& buffer = *buffers[i];
+			Entity spawned = buffer.CreateEntity();
+			EXPECT_TRUE(CommandBuffer::IsPlaceholder(spawned.GetId()));
+			buffer.AddComponent<PositionComponent>(spawned, PositionComponent{ (int)i });
+			buffer.AddComponent<VelocityComponent>(spawned);
+			buffer.AddComponent<VelocityComponent>(targets[i], VelocityComponent{ (int)i });
+			if (i == 3) {
+				buffer.RemoveComponent<PositionComponent>(targets[i]);
+				buffer.KillEntity(targets[0]);
+			}
+		}
+		});
+	EXPECT_FALSE(registry.HasComponent<VelocityComponent>(targets[1]));
+
+	registry.Update();
+	EXPECT_FALSE(registry.IsValid(targets[0]));
+	EXPECT_EQ(registry.GetComponent<VelocityComponent>(targets[2]).dx, 2);
+	EXPECT_FALSE(registry.HasComponent<PositionComponent>(targets[3]));
+
+	// Spawned entities are created in buffer order
+	std::vector<int> spawned;
+	registry.View<PositionComponent, VelocityComponent>([&](EntityID id, PositionComponent& p, VelocityComponent&) {
+		if (GetEntityIndex(id) >= 4)
+			spawned.push_back(p.x * 100 + (int)GetEntityIndex(id));
+		});
+	std::sort(spawned.begin(), spawned.end());
+	EXPECT_EQ(spawned, (std::vector<int>{ 4, 105, 206, 307 }));
+	for (CommandBuffer* buffer : buffers)
+		EXPECT_TRUE(buffer->IsEmpty());
+}
+
+TEST(ECSTest, SnapshotRoundTrip) {
+	using namespace ECS;
+	const std::string path = (std::filesystem::temp_directory_path() / "ecs_snapshot_test.bin").string();
+
+	std::vector<EntityID> ids;
+	{
+		Registry registry;
+		for (int i = 0; i < 100; ++i) {
+			auto e = registry.CreateEntity();
+			ids.push_back(e.GetId());
+			registry.AddComponent<PositionComponent>(e, PositionComponent{ i });
+			if (i % 2 == 0)
+				registry.AddComponent<VelocityComponent>(e, VelocityComponent{ -i });
+		}
+		registry.KillEntity(Entity(ids[10], &registry));
+		registry.Update();
+		ASSERT_TRUE((registry.SaveSnapshot<PositionComponent, VelocityComponent>(path)));
+	}
+
+	Registry loaded;
+	ASSERT_TRUE((loaded.LoadSnapshot<PositionComponent, VelocityComponent>(path)));
+
+	// A pool listing an entity twice is rejected before anything is loaded
+	{
+		std::vector<char> bytes(std::filesystem::file_size(path));
+		std::ifstream(path, std::ios::binary).read(bytes.data(), (std::streamsize)bytes.size());
+		auto aligned = [](size_t size) { return (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT; };
+		const size_t positionIds = aligned(sizeof(SnapshotHeader)) + aligned(100 * sizeof(u32)) + aligned(sizeof(u32)) + aligned(sizeof(SnapshotPoolHeader));
+		ASSERT_EQ(std::memcmp(bytes.data() + positionIds, &ids[0], sizeof(EntityID)), 0);
+		std::memcpy(bytes.data() + positionIds + sizeof(EntityID), bytes.data() + positionIds, sizeof(EntityID));
+
+		const std::string corruptPath = path + ".corrupt";
+		std::ofstream(corruptPath, std::ios::binary).write(bytes.data(), (std::streamsize)bytes.size());
+		Registry corrupt;
+		EXPECT_FALSE((corrupt.LoadSnapshot<PositionComponent, VelocityComponent>(corruptPath)));
+		std::filesystem::remove(corruptPath);
+
+		corrupt.Update();
+		EXPECT_EQ(GetEntityIndex(corrupt.CreateEntity().GetId()), 0u);
+		int corruptCount = 0;
+		corrupt.View<PositionComponent>([&](EntityID, PositionComponent&) { ++corruptCount; });
+		EXPECT_EQ(corruptCount, 0);
+	}
+	std::filesystem::remove(path);
+
+	EXPECT_FALSE(loaded.IsValid(Entity(ids[10], &loaded)));
+	Entity e42(ids[42], &loaded);
+	EXPECT_TRUE(loaded.IsValid(e42));
+	EXPECT_EQ(loaded.GetComponent<PositionComponent>(e42).x, 42);
+	EXPECT_EQ(loaded.GetComponent<VelocityComponent>(e42).dx, -42);
+	EXPECT_FALSE(loaded.HasComponent<VelocityComponent>(Entity(ids[43], &loaded)));
+
+	int count = 0;
+	loaded.View<PositionComponent, VelocityComponent>([&](EntityID, PositionComponent& p, VelocityComponent& v) {
+		EXPECT_EQ(p.x, -v.dx);
+		++count;
+		});
+	EXPECT_EQ(count, 49);
+
+	// The free list is restored: the killed index is recycled with a new version
+	auto recycled = loaded.CreateEntity();
+	EXPECT_EQ(GetEntityIndex(recycled.GetId()), 10u);
+	EXPECT_NE(recycled.GetId(), ids[10]);
+
+	Registry invalid;
+	EXPECT_FALSE(invalid.LoadSnapshot<PositionComponent>(path));
+}
+
+TEST(ECSTest, DeltaReplicationMirrorsServer) {
+	using namespace ECS;
+	Registry server;
+	server.EnableChangeTracking<PositionComponent>();
+	server.EnableChangeTracking<VelocityComponent>();
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; ++i) {
+		auto e = server.CreateEntity();
+		entities.push_back(e);
+		server.AddComponent<PositionComponent>(e, PositionComponent{ i });
+		server.AddComponent<VelocityComponent>(e, VelocityComponent{ i });
+	}
+	server.Update();
+
+	// A joining client gets the full state
+	Registry client;
+	std::vector<u8> full;
+	server.WriteDelta<PositionComponent, VelocityComponent>(0, full);
+	ASSERT_TRUE((client.ApplyDelta<PositionComponent, VelocityComponent>(full)));
+	client.Update();
+	u32 lastTick = server.GetTick();
+
+	server.GetMutableComponent<PositionComponent>(entities[3]).x = 30;
+	server.RemoveComponent<VelocityComponent>(entities[4]);
+	server.KillEntity(entities[5]);
+	auto spawned = server.CreateEntity();
+	server.AddComponent<PositionComponent>(spawned, PositionComponent{ 99 });
+	server.Update();
+
+	std::vector<u8> delta;
+	server.WriteDelta<PositionComponent, VelocityComponent>(lastTick, delta);
+	EXPECT_LT(delta.size(), full.size());
+	ASSERT_TRUE((client.ApplyDelta<PositionComponent, VelocityComponent>(delta)));
+	client.Update();
+
+	EXPECT_EQ(client.GetComponent<PositionComponent>(Entity(entities[3].GetId(), &client)).x, 30);
+	EXPECT_EQ(client.GetComponent<PositionComponent>(Entity(entities[7].GetId(), &client)).x, 7);
+	EXPECT_FALSE(client.HasComponent<VelocityComponent>(Entity(entities[4].GetId(), &client)));
+	EXPECT_FALSE(client.IsValid(Entity(entities[5].GetId(), &client)));
+	Entity replicated(spawned.GetId(), &client);
+	ASSERT_TRUE(client.IsValid(replicated));
+	EXPECT_EQ(client.GetComponent<PositionComponent>(replicated).x, 99);
+
+	int count = 0;
+	client.View<PositionComponent>([&](EntityID, PositionComponent&) { ++count; });
+	EXPECT_EQ(count, 10);
+
+	// The index of a killed entity reused by the server within the same delta
+	lastTick = server.GetTick();
+	server.KillEntity(entities[6]);
+	server.Update();
+	auto reused = server.CreateEntity();
+	ASSERT_EQ(GetEntityIndex(reused.GetId()), GetEntityIndex(entities[6].GetId()));
+	server.AddComponent<PositionComponent>(reused, PositionComponent{ 60 });
+
+	delta.clear();
+	server.WriteDelta<PositionComponent, VelocityComponent>(lastTick, delta);
+	ASSERT_TRUE((client.ApplyDelta<PositionComponent, VelocityComponent>(delta)));
+	client.Update();
+
+	EXPECT_FALSE(client.IsValid(Entity(entities[6].GetId(), &client)));
+	Entity reusedReplica(reused.GetId(), &client);
+	ASSERT_TRUE(client.IsValid(reusedReplica));
+	EXPECT_EQ(client.GetComponent<PositionComponent>(reusedReplica).x, 60);
+	EXPECT_FALSE(client.HasComponent<VelocityComponent>(reusedReplica));
+
+	// The adopted indices left the free list, the others are still reused
+	EXPECT_EQ(client.GetFreeEntityCount(), server.GetFreeEntityCount());
+	EXPECT_EQ(GetEntityIndex(client.CreateEntity().GetId()), GetEntityIndex(entities[5].GetId()));
+}
+
+namespace
+{
+	// Counts the bytes still allocated through it
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t allocated = 0;
+		size_t allocations = 0;
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			allocated += bytes;
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override
+		{
+			allocated -= bytes;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+}
+
+TEST(ECSTest, RegistryAllocatesFromMemoryResource) {
+	using namespace ECS;
+	for (StorageMode mode : { StorageMode::SparseSet, StorageMode::Archetype }) {
+		CountingResource resource;
+		{
+			Registry registry(mode, &resource);
+			EXPECT_EQ(registry.GetMemoryResource(), &resource);
+			if (mode == StorageMode::SparseSet)
+				registry.EnableChangeTracking<PositionComponent>();
+			for (int i = 0; i < 1000; ++i) {
+				auto e = registry.CreateEntity();
+				registry.AddComponent<PositionComponent>(e, PositionComponent{ i });
+				registry.AddComponent<VelocityComponent>(e);
+				if (i % 10 == 0)
+					e.Group("tenth");
+			}
+			registry.Update();
+			EXPECT_GT(resource.allocations, 0u);
+
+			long long sum = 0;
+			registry.View<PositionComponent, VelocityComponent>([&](EntityID, PositionComponent& p, VelocityComponent&) { sum += p.x; });
+			EXPECT_EQ(sum, 999 * 1000 / 2);
+		}
+		// Everything allocated from the resource is given back with the registry
+		EXPECT_EQ(resource.allocated, 0u);
+	}
+}
+
+TEST(ECSTest, RegistriesHaveTheirOwnComponentIds) {
+	using namespace ECS;
+	struct MoveSystem : System
+	{
+		MoveSystem() { WriteComponent<PositionComponent>(); ReadComponent<VelocityComponent>(); }
+	};
+
+	// Same types, registered in a different order
+	Registry first;
+	first.RegisterComponents<PositionComponent, VelocityComponent>();
+	Registry second;
+	second.RegisterComponents<TestComponent, VelocityComponent, PositionComponent>();
+
+	EXPECT_EQ(first.GetComponentCount(), 2u);
+	EXPECT_EQ(first.GetComponentId<PositionComponent>(), 0u);
+	EXPECT_EQ(second.GetComponentId<PositionComponent>(), 2u);
+	EXPECT_EQ(first.GetComponentId<TestComponent>(), u32_invalid_id);
+	EXPECT_FALSE(first.HasComponent<TestComponent>(first.CreateEntity()));
+
+	for (Registry* registry : { &first, &second }) {
+		registry->AddSystem<MoveSystem>();
+		auto moving = registry->CreateEntity();
+		registry->AddComponent<PositionComponent>(moving);
+		registry->AddComponent<VelocityComponent>(moving);
+		registry->AddComponent<PositionComponent>(registry->CreateEntity());
+		registry->Update();
+
+		const MoveSystem& system = registry->GetSystem<MoveSystem>();
+		EXPECT_TRUE(system.GetWriteSignature().test(registry->GetComponentId<PositionComponent>()));
+		EXPECT_TRUE(system.GetReadSignature().test(registry->GetComponentId<VelocityComponent>()));
+		ASSERT_EQ(system.GetSystemEntities().size(), 1u);
+		EXPECT_EQ(system.GetSystemEntities()[0], moving);
+	}
+}
+
+TEST(ECSTest, RestoreFromRollsBackAndSkipsUnchangedPools) {
+	using namespace ECS;
+	struct MoveSystem : System
+	{
+		MoveSystem() { WriteComponent<PositionComponent>(); ReadComponent<VelocityComponent>(); }
+	};
+
+	Registry world;
+	world.AddSystem<MoveSystem>();
+	std::vector<Entity> entities;
+	for (int i = 0; i < 100; ++i) {
+		auto e = world.CreateEntity();
+		world.AddComponent<PositionComponent>(e, PositionComponent{ i });
+		if (i % 2 == 0)
+			world.AddComponent<VelocityComponent>(e, VelocityComponent{ 1 });
+		entities.push_back(e);
+	}
+	entities[0].Tag("first");
+	world.Update();
+
+	auto saved = world.Clone();
+	EXPECT_TRUE(saved->HasComponent<PositionComponent>(entities[99]));
+	EXPECT_EQ(saved->RestoreFrom(world), 0u); // Nothing changed since the clone
+	EXPECT_EQ(saved->GetConstComponent<PositionComponent>(entities[42]).x, 42);
+
+	// Simulate a frame, only the positions change
+	world.View<PositionComponent, VelocityComponent>([](EntityID, PositionComponent& p, VelocityComponent& v) { p.x += v.dx; });
+	entities[2].Kill();
+	world.Update();
+	EXPECT_EQ(world.GetComponent<PositionComponent>(entities[4]).x, 5);
+	EXPECT_EQ(world.GetSystem<MoveSystem>().GetSystemEntities().size(), 49u);
+
+	// Roll back
+	EXPECT_EQ(world.RestoreFrom(*saved), 2u);
+	EXPECT_EQ(world.RestoreFrom(*saved), 0u);
+	EXPECT_TRUE(world.IsValid(entities[2]));
+	EXPECT_EQ(world.GetComponent<PositionComponent>(entities[4]).x, 4);
+	EXPECT_EQ(world.GetSystem<MoveSystem>().GetSystemEntities().size(), 50u);
+	EXPECT_EQ(world.GetEntityByTag("first"), entities[0]);
+
+	// Saving again only copies the pool written by the view
+	world.View<PositionComponent>([](EntityID, PositionComponent& p) { p.x = -p.x; });
+	saved->RestoreFrom(world);
+	world.View<PositionComponent>([](EntityID, PositionComponent& p) { p.x = -p.x; });
+	EXPECT_EQ(saved->RestoreFrom(world), 1u);
+	EXPECT_EQ(saved->GetConstComponent<PositionComponent>(entities[4]).x, 4);
+
+	// Reads leave the pools uncopied, only the mutable view term is
+	int sum = 0;
+	world.View<const PositionComponent, const VelocityComponent>([&sum](EntityID, const PositionComponent& p, const VelocityComponent& v) { sum += p.x * v.dx; });
+	sum += world.GetConstComponent<PositionComponent>(entities[4]).x;
+	EXPECT_EQ(sum, 2454);
+	EXPECT_EQ(saved->RestoreFrom(world), 0u);
+
+	world.View<PositionComponent, const VelocityComponent>([](EntityID, PositionComponent& p, const VelocityComponent& v) { p.x += v.dx; });
+	EXPECT_EQ(saved->RestoreFrom(world), 1u);
+	EXPECT_EQ(saved->GetConstComponent<PositionComponent>(entities[4]).x, 5);
+
+	// Writes through GetComponent() are rolled back too
+	world.RestoreFrom(*saved);
+	world.GetComponent<PositionComponent>(entities[4]).x = 77;
+	EXPECT_EQ(world.RestoreFrom(*saved), 1u);
+	EXPECT_EQ(world.GetConstComponent<PositionComponent>(entities[4]).x, 5);
+	entities[4].GetComponent<PositionComponent>().x = 78;
+	EXPECT_EQ(world.RestoreFrom(*saved), 1u);
+	EXPECT_EQ(world.GetConstComponent<PositionComponent>(entities[4]).x, 5);
+}
+
+TEST(ECSTest, SortReordersPoolsInPlace) {
+	using namespace ECS;
+	Registry registry;
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; ++i) {
+		auto e = registry.CreateEntity();
+		registry.AddComponent<PositionComponent>(e, PositionComponent{ (i * 7) % 10 });
+		if (i % 3 != 0)
+			registry.AddComponent<VelocityComponent>(e, VelocityComponent{ i });
+		entities.push_back(e);
+	}
+	registry.Update();
+
+	auto positions = [&registry]() {
+		std::vector<int> values;
+		registry.View<PositionComponent>([&](EntityID, PositionComponent& p) { values.push_back(p.x); });
+		return values;
+		};
+
+	registry.Sort<PositionComponent>([](const PositionComponent& a, const PositionComponent& b) { return a.x < b.x; });
+	std::vector<int> sorted = positions();
+	EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+	for (int i = 0; i < 10; ++i)
+		EXPECT_EQ(registry.GetComponent<PositionComponent>(entities[i]).x, (i * 7) % 10);
+
+	// Velocities follow the position order
+	registry.SortAs<VelocityComponent, PositionComponent>();
+	std::vector<EntityID> positionOrder, velocityOrder;
+	registry.View<PositionComponent>([&](EntityID id, PositionComponent&) {
+		if (registry.HasComponent<VelocityComponent>(Entity(id, &registry)))
+			positionOrder.push_back(id);
+		});
+	registry.View<VelocityComponent>([&](EntityID id, VelocityComponent&) { velocityOrder.push_back(id); });
+	EXPECT_EQ(positionOrder, velocityOrder);
+
+	// Back to the spawn order, a swap at a time
+	u32 calls = 1;
+	while (!registry.SortIncremental<PositionComponent>(std::less<EntityID>(), 1))
+		calls++;
+	EXPECT_GT(calls, 1u);
+	std::vector<EntityID> spawnOrder;
+	registry.View<PositionComponent>([&](EntityID id, PositionComponent&) { spawnOrder.push_back(id); });
+	EXPECT_TRUE(std::is_sorted(spawnOrder.begin(), spawnOrder.end()));
+	EXPECT_EQ(registry.GetComponent<PositionComponent>(entities[3]).x, 1);
+}
+
+TEST(ECSTest, EmptyComponentPoolsOnlyStoreEntities) {
+	using namespace ECS;
+	struct Frozen {};
+	static_assert(EmptyComponent<Frozen> && !EmptyComponent<PositionComponent>);
+
+	Registry registry;
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; ++i) {
+		auto e = registry.CreateEntity();
+		registry.AddComponent<PositionComponent>(e, PositionComponent{ i });
+		if (i % 2 == 0)
+			registry.AddComponent<Frozen>(e);
+		entities.push_back(e);
+	}
+	registry.Update();
+	registry.RemoveComponent<Frozen>(entities[4]);
+
+	// Every entity shares the same instance
+	EXPECT_EQ(&registry.GetComponent<Frozen>(entities[0]), &registry.GetComponent<Frozen>(entities[2]));
+	EXPECT_FALSE(registry.HasComponent<Frozen>(entities[4]));
+
+	int sum = 0;
+	registry.View<PositionComponent, Frozen>([&](EntityID, PositionComponent& p, Frozen&) { sum += p.x; });
+	EXPECT_EQ(sum, 0 + 2 + 6 + 8);
+
+	size_t frozen = 0;
+	registry.ForEachChunk<Frozen>([&](std::span<const EntityID> ids, std::span<Frozen> components) {
+		EXPECT_EQ(ids.size(), components.size());
+		frozen += ids.size();
+		});
+	EXPECT_EQ(frozen, 4u);
+}
+
+TEST(ECSTest, ViewExcludeAndOptionalFilters) {
+	using namespace ECS;
+	struct Dead {};
+
+	for (StorageMode mode : { StorageMode::SparseSet, StorageMode::Archetype }) {
+		Registry registry(mode);
+		std::vector<Entity> entities;
+		for (int i = 0; i < 12; ++i) {
+			auto e = registry.CreateEntity();
+			registry.AddComponent<PositionComponent>(e, PositionComponent{ i });
+			if (i % 2 == 0)
+				registry.AddComponent<VelocityComponent>(e, VelocityComponent{ i * 10 });
+			if (i % 3 == 0)
+				registry.AddComponent<Dead>(e);
+			entities.push_back(e);
+		}
+		registry.Update();
+
+		// Alive: 1 2 4 5 7 8 10 11, with a velocity: 2 4 8 10
+		int alive = 0, moving = 0, velocitySum = 0;
+		registry.View<PositionComponent, Exclude<Dead>, Optional<VelocityComponent>>([&](EntityID, PositionComponent& p, VelocityComponent* v) {
+			EXPECT_NE(p.x % 3, 0);
+			alive++;
+			if (v) {
+				EXPECT_EQ(v->dx, p.x * 10);
+				moving++;
+				velocitySum += v->dx;
+			}
+			});
+		EXPECT_EQ(alive, 8);
+		EXPECT_EQ(moving, 4);
+		EXPECT_EQ(velocitySum, 240);
+
+		// Optional arguments keep their declared position, excluding a type no entity has excludes nothing
+		int count = 0;
+		registry.View<Optional<VelocityComponent>, PositionComponent, Exclude<TestComponent>>([&](EntityID id, VelocityComponent*, PositionComponent& p) {
+			EXPECT_EQ(registry.GetComponent<PositionComponent>(Entity(id, &registry)).x, p.x);
+			count++;
+			});
+		EXPECT_EQ(count, 12);
+	}
+}
+
+TEST(ECSTest, ProfilerTracesEventsAndPoolStats) {
+	using namespace ECS;
+
+	// Standalone: events, frame counters and the Chrome trace
+	Profiler profiler;
+	{
+		ProfileScope scope(profiler, "Physics");
+		scope.SetEntityCount(128);
+	}
+	profiler.GetCurrentFrame().entitiesCreated += 3;
+	profiler.NextFrame(7);
+
+	ASSERT_EQ(profiler.GetEvents().size(), 1u);
+	EXPECT_EQ(profiler.GetEvents()[0].name, "Physics");
+	EXPECT_EQ(profiler.GetEvents()[0].entityCount, 128u);
+	ASSERT_EQ(profiler.GetFrames().size(), 2u);
+	EXPECT_EQ(profiler.GetFrames()[0].entitiesCreated, 3u);
+	EXPECT_EQ(profiler.GetFrames()[0].freeEntities, 7u);
+	EXPECT_EQ(profiler.GetCurrentFrame().frame, 1u);
+
+	std::stringstream trace;
+	profiler.WriteChromeTrace(trace);
+	EXPECT_NE(trace.str().find("\"name\":\"Physics\",\"cat\":\"ecs\",\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(trace.str().find("\"entities\":128"), std::string::npos);
+	EXPECT_NE(trace.str().find("\"created\":3"), std::string::npos);
+
+	// Timestamps in fixed notation with three decimals
+	const std::string json = trace.str();
+	const size_t tsBegin = json.find("\"ts\":") + 5;
+	const std::string ts = json.substr(tsBegin, json.find(',', tsBegin) - tsBegin);
+	EXPECT_EQ(ts.find_first_not_of("0123456789."), std::string::npos);
+	ASSERT_NE(ts.find('.'), std::string::npos);
+	EXPECT_EQ(ts.size() - ts.find('.'), 4u);
+
+	profiler.Clear();
+	EXPECT_TRUE(profiler.GetEvents().empty());
+	EXPECT_EQ(profiler.GetFrames().size(), 1u);
+
+	// Pool memory, available without ECS_ENABLE_PROFILING
+	Registry registry;
+	std::vector<Entity> entities;
+	for (int i = 0; i < 100; ++i) {
+		auto e = registry.CreateEntity();
+		entities.push_back(e);
+		e.AddComponent<PositionComponent>(PositionComponent{ i });
+		if (i < 10)
+			e.AddComponent<VelocityComponent>(VelocityComponent{ i });
+	}
+	registry.AddSystem<IntegrateSystem>();
+	registry.Update();
+
+	std::vector<PoolStats> stats = registry.GetPoolStats();
+	ASSERT_EQ(stats.size(), 2u);
+	for (const PoolStats& pool : stats) {
+		const bool position = pool.componentId == registry.GetComponentId<PositionComponent>();
+		EXPECT_EQ(pool.size, position ? 100u : 10u);
+		EXPECT_GE(pool.capacity, pool.size);
+		EXPECT_GE(pool.packedBytes, pool.size * (sizeof(int) + sizeof(EntityID)));
+		EXPECT_GE(pool.sparsePages, 1u);
+		EXPECT_NE(pool.name.find(position ? "PositionComponent" : "VelocityComponent"), std::string_view::npos);
+	}
+	EXPECT_NE(registry.GetSystem<IntegrateSystem>().GetName().find("IntegrateSystem"), std::string_view::npos);
+
+	entities[50].Kill();
+	registry.Update();
+	EXPECT_EQ(registry.GetFreeEntityCount(), 1u);
+
+#if ECS_ENABLE_PROFILING
+	// Built with profiling: Update() phases, systems and views are timed, frames count the changes
+	registry.GetProfiler().Clear();
+	registry.CreateEntity().AddComponent<PositionComponent>();
+	registry.RunSystems(0.0f);
+	int viewed = 0;
+	registry.View<PositionComponent, VelocityComponent>([&](EntityID, PositionComponent&, VelocityComponent&) { viewed++; });
+	registry.Update();
+
+	const FrameCounters& frame = registry.GetProfiler().GetFrames()[0];
+	EXPECT_EQ(frame.entitiesCreated, 1u);
+	EXPECT_EQ(frame.componentsAdded, 1u);
+	EXPECT_EQ(frame.freeEntities, 0u);
+
+	auto findEvent = [&](std::string_view name) -> const ProfileEvent* {
+		for (const ProfileEvent& event : registry.GetProfiler().GetEvents())
+			if (event.name.find(name) != std::string_view::npos)
+				return &event;
+		return nullptr;
+	};
+	ASSERT_NE(findEvent("IntegrateSystem"), nullptr);
+	EXPECT_EQ(findEvent("IntegrateSystem")->entityCount, 10u);
+	ASSERT_NE(findEvent("View<"), nullptr);
+	EXPECT_EQ(findEvent("View<")->entityCount, (u32)viewed);
+	EXPECT_NE(findEvent("Registry::Update"), nullptr);
+#endif
+}
+
+TEST(ECSTest, FreeListRecyclesIndicesAndHandlesVersionOverflow) {
+	using namespace ECS;
+	Registry registry;
+	registry.Reserve<PositionComponent>(256, { 128 });
+
+	std::vector<Entity> entities(100);
+	registry.CreateEntities(entities.size(), entities);
+	registry.Update();
+	entities[10].Kill();
+	entities[20].Kill();
+	registry.Update();
+	EXPECT_EQ(registry.GetFreeEntityCount(), 2u);
+	EXPECT_FALSE(registry.IsValid(entities[10]));
+
+	// Last freed index first, with a newer version, older handles stay invalid
+	Entity reused = registry.CreateEntity();
+	EXPECT_EQ(GetEntityIndex(reused.GetId()), 20u);
+	EXPECT_EQ(GetEntityVersion(reused.GetId()), 1u);
+	EXPECT_FALSE(registry.IsValid(entities[20]));
+	EXPECT_TRUE(registry.IsValid(reused));
+	EXPECT_EQ(GetEntityIndex(registry.CreateEntity().GetId()), 10u);
+	EXPECT_EQ(GetEntityIndex(registry.CreateEntity().GetId()), 100u);
+	EXPECT_EQ(registry.GetFreeEntityCount(), 0u);
+	registry.Update();
+
+	auto killAndRecreate = [&registry](Entity e) {
+		e.Kill();
+		registry.Update();
+		Entity next = registry.CreateEntity();
+		registry.Update();
+		return next;
+	};
+
+	// Wrap: the version restarts at 0 after the highest one
+	registry.SetVersionOverflow(VersionOverflow::Wrap, 2);
+	Entity e = entities[30];
+	std::vector<u32> versions;
+	for (int i = 0; i < 3; ++i) {
+		e = killAndRecreate(e);
+		EXPECT_EQ(GetEntityIndex(e.GetId()), 30u);
+		versions.push_back(GetEntityVersion(e.GetId()));
+	}
+	EXPECT_EQ(versions, (std::vector<u32>{ 1, 2, 0 }));
+
+	// Retire: the index killed at the highest version is never handed out again
+	registry.SetVersionOverflow(VersionOverflow::Retire, 1);
+	e = killAndRecreate(entities[40]);
+	EXPECT_EQ(GetEntityIndex(e.GetId()), 40u);
+	Entity last = killAndRecreate(e);
+	EXPECT_NE(GetEntityIndex(last.GetId()), 40u);
+	EXPECT_FALSE(registry.IsValid(e));
+	EXPECT_FALSE(registry.IsValid(Entity(CreateEntityId(40, 0), &registry)));
+	EXPECT_EQ(registry.GetFreeEntityCount(), 0u);
+
+	// Snapshots keep the free list order and the retired indices
+	entities[50].Kill();
+	entities[60].Kill();
+	registry.Update();
+	const std::string path = (std::filesystem::temp_directory_path() / "ecs_free_list.snapshot").string();
+	ASSERT_TRUE(registry.SaveSnapshot<PositionComponent>(path));
+	Registry loaded;
+	ASSERT_TRUE(loaded.LoadSnapshot<PositionComponent>(path));
+	std::filesystem::remove(path);
+	loaded.Update();
+
+	EXPECT_EQ(loaded.GetFreeEntityCount(), 2u);
+	EXPECT_FALSE(loaded.IsValid(e));
+	EXPECT_TRUE(loaded.IsValid(last));
+	EXPECT_EQ(GetEntityIndex(loaded.CreateEntity().GetId()), 60u);
+	EXPECT_EQ(GetEntityIndex(loaded.CreateEntity().GetId()), 50u);
+	EXPECT_EQ(GetEntityIndex(loaded.CreateEntity().GetId()), GetEntityIndex(last.GetId()) + 1);
+}